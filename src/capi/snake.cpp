@@ -0,0 +1,307 @@
+#include <new>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+
+#include <environment/snake_environment.hpp>
+#include <environment/snake_batch_environment.hpp>
+
+#include "snake.h"
+
+static_assert(static_cast<int>(SNAKE_ACTION_RIGHT) == static_cast<int>(SnakeEnvironment::RIGHT),
+              "snake_action must match SnakeEnvironment::Action");
+static_assert(static_cast<int>(SNAKE_CELL_HEAD) == static_cast<int>(SnakeGameplaySystem::SNAKE_HEAD) &&
+                  static_cast<int>(SNAKE_CELL_BODY) == static_cast<int>(SnakeGameplaySystem::SNAKE_BODY) &&
+                  static_cast<int>(SNAKE_CELL_APPLE) == static_cast<int>(SnakeGameplaySystem::APPLE) &&
+                  static_cast<int>(SNAKE_CELL_OBSTACLE) == static_cast<int>(SnakeGameplaySystem::OBSTACLE),
+              "snake_cell must match SnakeGameplaySystem::MapSlotState");
+
+struct snake_game
+{
+    explicit snake_game(const SnakeEnvironment::Config &config)
+        : env(config), actions(static_cast<size_t>(config.snakeCount), SnakeEnvironment::NONE),
+          results(static_cast<size_t>(config.snakeCount)) {}
+    SnakeEnvironment env;
+    std::vector<SnakeEnvironment::Action> actions; // bytes from the host are validated into here
+    std::vector<SnakeEnvironment::StepResult> results;
+}; // struct snake_game
+
+struct snake_batch
+{
+    snake_batch(const size_t &gameCount, const SnakeEnvironment::Config &config)
+        : env(gameCount, config), actions(gameCount, SnakeEnvironment::NONE) {}
+    SnakeBatchEnvironment env;
+    std::vector<SnakeEnvironment::Action> actions; // bytes from the host are validated into here
+}; // struct snake_batch
+
+namespace
+{
+    bool is_config_valid(const snake_config *config, const bool &isTimed)
+    {
+        if (config == nullptr || config->width < 2 || config->height < 1)
+            return false;
+        if (isTimed && (config->speed <= 0.0f || config->speed * static_cast<float>(config->tick_period_ms) > 500.0f))
+            return false;
+        if (isTimed ? (config->snake_count < 1 || config->snake_count > config->height) : config->snake_count != 1)
+            return false;
+        return true;
+    }
+
+    SnakeEnvironment::Config to_env_config(const snake_config *config)
+    {
+        SnakeEnvironment::Config ret;
+        ret.width = config->width;
+        ret.height = config->height;
+        ret.speed = config->speed;
+        ret.tickPeriodMs = config->tick_period_ms;
+        ret.snakeCount = config->snake_count;
+        return ret;
+    }
+
+    // Runs f, turning any exception into a status code so that none unwinds into the host.
+    template <typename F>
+    snake_result guard(F &&f)
+    {
+        try
+        {
+            return f();
+        }
+        catch (const std::bad_alloc &)
+        {
+            return SNAKE_ERROR_OUT_OF_MEMORY;
+        }
+        catch (...)
+        {
+            return SNAKE_ERROR_INTERNAL;
+        }
+    }
+} // namespace
+
+extern "C"
+{
+    SNAKE_API uint32_t snake_get_abi_version(void) { return SNAKE_ABI_VERSION; }
+
+    SNAKE_API void snake_config_init(snake_config *config)
+    {
+        if (config == nullptr)
+            return;
+        const SnakeEnvironment::Config defaults;
+        config->width = defaults.width;
+        config->height = defaults.height;
+        config->speed = defaults.speed;
+        config->tick_period_ms = defaults.tickPeriodMs;
+        config->snake_count = defaults.snakeCount;
+    }
+
+    SNAKE_API snake_result snake_game_create(const snake_config *config, uint64_t seed, snake_game **game)
+    {
+        if (game == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        *game = nullptr;
+        if (!is_config_valid(config, true))
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        return guard([&]()
+                     {
+                         snake_game *ret = new snake_game(to_env_config(config));
+                         ret->env.reset(seed);
+                         *game = ret;
+                         return SNAKE_OK; });
+    }
+
+    SNAKE_API void snake_game_destroy(snake_game *game) { delete game; }
+
+    SNAKE_API snake_result snake_game_reset(snake_game *game, uint64_t seed)
+    {
+        if (game == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        return guard([&]()
+                     {
+                         game->env.reset(seed);
+                         return SNAKE_OK; });
+    }
+
+    SNAKE_API snake_result snake_game_step(snake_game *game, snake_action action, float *reward, int *done)
+    {
+        if (game == nullptr || action < SNAKE_ACTION_NONE || action > SNAKE_ACTION_RIGHT)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        return guard([&]()
+                     {
+                         const SnakeEnvironment::StepResult result = game->env.step(static_cast<SnakeEnvironment::Action>(action));
+                         if (reward != nullptr)
+                             *reward = result.reward;
+                         if (done != nullptr)
+                             *done = result.done ? 1 : 0;
+                         return SNAKE_OK; });
+    }
+
+    SNAKE_API snake_result snake_game_get_score(const snake_game *game, uint64_t *score)
+    {
+        if (game == nullptr || score == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        *score = game->env.get_score();
+        return SNAKE_OK;
+    }
+
+    SNAKE_API size_t snake_game_get_snake_count(const snake_game *game)
+    {
+        return game == nullptr ? 0U : game->env.get_snake_count();
+    }
+
+    SNAKE_API snake_result snake_game_step_snakes(snake_game *game, const uint8_t *actions, float *rewards, uint8_t *dones)
+    {
+        if (game == nullptr || actions == nullptr || rewards == nullptr || dones == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        const size_t snakeCount = game->env.get_snake_count();
+        for (size_t k = 0; k < snakeCount; k++)
+        {
+            if (actions[k] >= SnakeEnvironment::ACTION_END)
+                return SNAKE_ERROR_INVALID_ARGUMENT;
+            game->actions[k] = static_cast<SnakeEnvironment::Action>(actions[k]);
+        }
+        return guard([&]()
+                     {
+                         game->env.step(game->actions.data(), game->results.data());
+                         for (size_t k = 0; k < snakeCount; k++)
+                         {
+                             rewards[k] = game->results[k].reward;
+                             dones[k] = game->results[k].done ? 1U : 0U;
+                         }
+                         return SNAKE_OK; });
+    }
+
+    SNAKE_API snake_result snake_game_get_snake_score(const snake_game *game, size_t snake, uint64_t *score)
+    {
+        if (game == nullptr || score == nullptr || snake >= game->env.get_snake_count())
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        *score = game->env.get_score(snake);
+        return SNAKE_OK;
+    }
+
+    SNAKE_API snake_result snake_game_get_status(const snake_game *game, snake_status *status)
+    {
+        if (game == nullptr || status == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        if (!game->env.is_done())
+            *status = SNAKE_STATUS_RUNNING;
+        else
+            *status = game->env.is_success() ? SNAKE_STATUS_SUCCESS : SNAKE_STATUS_FAILURE;
+        return SNAKE_OK;
+    }
+
+    SNAKE_API size_t snake_game_get_board_size(const snake_game *game)
+    {
+        if (game == nullptr)
+            return 0U;
+        return static_cast<size_t>(game->env.get_config().width) * static_cast<size_t>(game->env.get_config().height);
+    }
+
+    SNAKE_API snake_result snake_game_export_board(const snake_game *game, uint8_t *buffer, size_t size)
+    {
+        if (game == nullptr || buffer == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        if (size < snake_game_get_board_size(game))
+            return SNAKE_ERROR_BUFFER_TOO_SMALL;
+        return guard([&]()
+                     {
+                         game->env.export_board(buffer);
+                         return SNAKE_OK; });
+    }
+
+    SNAKE_API snake_result snake_game_load_obstacles(snake_game *game, const uint8_t *mask, size_t size)
+    {
+        if (game == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        if (mask != nullptr && size < snake_game_get_board_size(game))
+            return SNAKE_ERROR_BUFFER_TOO_SMALL;
+        if (mask != nullptr)
+        {
+            size_t openCount = 0U;
+            for (size_t cell = 0; cell < snake_game_get_board_size(game); cell++)
+                openCount += mask[cell] == 0U;
+            if (openCount < 2U)
+                return SNAKE_ERROR_INVALID_ARGUMENT;
+        }
+        return guard([&]()
+                     {
+                         game->env.load_obstacles(mask);
+                         return SNAKE_OK; });
+    }
+
+    SNAKE_API snake_result snake_game_load_level(snake_game *game, const char *text, size_t length)
+    {
+        if (game == nullptr || (text == nullptr && length > 0U))
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        return guard([&]()
+                     {
+                         if (text == nullptr)
+                         {
+                             game->env.load_obstacles(nullptr);
+                             return SNAKE_OK;
+                         }
+                         return game->env.load_level(text, length) ? SNAKE_OK : SNAKE_ERROR_INVALID_ARGUMENT; });
+    }
+
+    SNAKE_API snake_result snake_batch_create(size_t game_count, const snake_config *config, uint64_t seed, snake_batch **batch)
+    {
+        if (batch == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        *batch = nullptr;
+        if (game_count == 0U || !is_config_valid(config, false))
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        return guard([&]()
+                     {
+                         snake_batch *ret = new snake_batch(game_count, to_env_config(config));
+                         ret->env.reset(seed);
+                         *batch = ret;
+                         return SNAKE_OK; });
+    }
+
+    SNAKE_API void snake_batch_destroy(snake_batch *batch) { delete batch; }
+
+    SNAKE_API snake_result snake_batch_reset(snake_batch *batch, uint64_t seed)
+    {
+        if (batch == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        batch->env.reset(seed);
+        return SNAKE_OK;
+    }
+
+    SNAKE_API size_t snake_batch_get_game_count(const snake_batch *batch)
+    {
+        return batch == nullptr ? 0U : batch->env.get_game_count();
+    }
+
+    SNAKE_API snake_result snake_batch_step(snake_batch *batch, const uint8_t *actions, float *rewards, uint8_t *dones)
+    {
+        if (batch == nullptr || actions == nullptr || rewards == nullptr || dones == nullptr)
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        const size_t gameCount = batch->env.get_game_count();
+        for (size_t g = 0; g < gameCount; g++)
+            batch->actions[g] = static_cast<SnakeEnvironment::Action>(actions[g] < SnakeEnvironment::ACTION_END ? actions[g] : Uint8(SnakeEnvironment::NONE));
+        batch->env.step(batch->actions.data(), rewards, dones);
+        return SNAKE_OK;
+    }
+
+    SNAKE_API snake_result snake_batch_get_score(const snake_batch *batch, size_t game, uint64_t *score)
+    {
+        if (batch == nullptr || score == nullptr || game >= batch->env.get_game_count())
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        *score = batch->env.get_score(game);
+        return SNAKE_OK;
+    }
+
+    SNAKE_API size_t snake_batch_get_board_size(const snake_batch *batch)
+    {
+        return batch == nullptr ? 0U : batch->env.get_observation_size() / batch->env.get_game_count() / SnakeEnvironment::PLANE_COUNT;
+    }
+
+    SNAKE_API snake_result snake_batch_export_board(const snake_batch *batch, size_t game, uint8_t *buffer, size_t size)
+    {
+        if (batch == nullptr || buffer == nullptr || game >= batch->env.get_game_count())
+            return SNAKE_ERROR_INVALID_ARGUMENT;
+        if (size < snake_batch_get_board_size(batch))
+            return SNAKE_ERROR_BUFFER_TOO_SMALL;
+        batch->env.export_board(game, buffer);
+        return SNAKE_OK;
+    }
+} // extern "C"
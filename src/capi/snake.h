@@ -0,0 +1,129 @@
+#ifndef SRC_CAPI_SNAKE_H
+#define SRC_CAPI_SNAKE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * C interface of libsnake for hosts that cannot build the header-only ECS.
+ * Handles are opaque, no C++ exception crosses this boundary and every call
+ * that can fail returns a snake_result.
+ *
+ * A snake_game wraps SnakeEnvironment (the same systems as the game) and a
+ * snake_batch wraps SnakeBatchEnvironment. Both are self-contained, with their
+ * own state and random stream: handles may be stepped in any order, and
+ * distinct handles from distinct threads. A single handle is not thread-safe.
+ *
+ * A snake_game hosts snake_config.snake_count snakes on one board; snakes are
+ * numbered 0 .. snake_game_get_snake_count() - 1 from the top row down.
+ */
+
+#if defined(_WIN32)
+#if defined(SNAKE_BUILDING_LIBRARY)
+#define SNAKE_API __declspec(dllexport)
+#else
+#define SNAKE_API __declspec(dllimport)
+#endif
+#else
+#define SNAKE_API __attribute__((visibility("default")))
+#endif
+
+#define SNAKE_ABI_VERSION 2U
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct snake_game snake_game;
+    typedef struct snake_batch snake_batch;
+
+    typedef enum snake_result
+    {
+        SNAKE_OK = 0,
+        SNAKE_ERROR_INVALID_ARGUMENT = -1,
+        SNAKE_ERROR_BUFFER_TOO_SMALL = -2,
+        SNAKE_ERROR_OUT_OF_MEMORY = -3,
+        SNAKE_ERROR_INTERNAL = -4,
+    } snake_result;
+
+    /* same values as SnakeEnvironment::Action */
+    typedef enum snake_action
+    {
+        SNAKE_ACTION_NONE = 0, /* keep the current direction */
+        SNAKE_ACTION_UP = 1,
+        SNAKE_ACTION_LEFT = 2,
+        SNAKE_ACTION_DOWN = 3,
+        SNAKE_ACTION_RIGHT = 4,
+    } snake_action;
+
+    typedef enum snake_status
+    {
+        SNAKE_STATUS_RUNNING = 0,
+        SNAKE_STATUS_SUCCESS = 1,
+        SNAKE_STATUS_FAILURE = 2,
+    } snake_status;
+
+    /* board cells are bit flags, same values as SnakeGameplaySystem::MapSlotState */
+    typedef enum snake_cell
+    {
+        SNAKE_CELL_EMPTY = 0x0,
+        SNAKE_CELL_HEAD = 0x1,
+        SNAKE_CELL_BODY = 0x2,
+        SNAKE_CELL_APPLE = 0x4,
+        SNAKE_CELL_OBSTACLE = 0x8,
+    } snake_cell;
+
+    typedef struct snake_config
+    {
+        int32_t width;           /* MUST BE >= 2 */
+        int32_t height;          /* MUST BE >= 1 */
+        float speed;             /* units per second, snake_game only */
+        uint64_t tick_period_ms; /* speed * tick_period_ms MUST BE <= 500, snake_game only */
+        int32_t snake_count;     /* >= 1 and <= height for snake_game, 1 for snake_batch */
+    } snake_config;
+
+    SNAKE_API uint32_t snake_get_abi_version(void);
+    /* fills the defaults of SnakeEnvironment::Config */
+    SNAKE_API void snake_config_init(snake_config *config);
+
+    /* Single game. seed 0 picks a time-based seed. */
+    SNAKE_API snake_result snake_game_create(const snake_config *config, uint64_t seed, snake_game **game);
+    SNAKE_API void snake_game_destroy(snake_game *game); /* NULL is ignored */
+    SNAKE_API snake_result snake_game_reset(snake_game *game, uint64_t seed);
+    /* advances until the head enters the next cell; reward and done may be NULL. Every snake
+     * takes the action, and reward and done are the whole board's. */
+    SNAKE_API snake_result snake_game_step(snake_game *game, snake_action action, float *reward, int *done);
+    SNAKE_API snake_result snake_game_get_score(const snake_game *game, uint64_t *score);
+    SNAKE_API size_t snake_game_get_snake_count(const snake_game *game);
+    /* One action per snake; actions, rewards and dones hold snake_game_get_snake_count() entries
+     * each. A snake is done once it crashed, and its body then leaves the board. */
+    SNAKE_API snake_result snake_game_step_snakes(snake_game *game, const uint8_t *actions, float *rewards, uint8_t *dones);
+    SNAKE_API snake_result snake_game_get_snake_score(const snake_game *game, size_t snake, uint64_t *score);
+    SNAKE_API snake_result snake_game_get_status(const snake_game *game, snake_status *status);
+    /* width * height snake_cell bytes, row 0 is the top row */
+    SNAKE_API size_t snake_game_get_board_size(const snake_game *game);
+    SNAKE_API snake_result snake_game_export_board(const snake_game *game, uint8_t *buffer, size_t size);
+    /* Obstacles from the next snake_game_reset() on: mask holds snake_game_get_board_size()
+     * bytes, non-zero on a blocked cell, and leaves at least two cells open; NULL opens the board. */
+    SNAKE_API snake_result snake_game_load_obstacles(snake_game *game, const uint8_t *mask, size_t size);
+    /* Same with a level drawn as text, one line per row from the top and '#' on a blocked cell. */
+    SNAKE_API snake_result snake_game_load_level(snake_game *game, const char *text, size_t length);
+
+    /* Batch of games stepped in lockstep, one cell per step; finished games reset themselves. */
+    SNAKE_API snake_result snake_batch_create(size_t game_count, const snake_config *config, uint64_t seed, snake_batch **batch);
+    SNAKE_API void snake_batch_destroy(snake_batch *batch); /* NULL is ignored */
+    SNAKE_API snake_result snake_batch_reset(snake_batch *batch, uint64_t seed);
+    SNAKE_API size_t snake_batch_get_game_count(const snake_batch *batch);
+    /* actions, rewards and dones hold snake_batch_get_game_count() entries each */
+    SNAKE_API snake_result snake_batch_step(snake_batch *batch, const uint8_t *actions, float *rewards, uint8_t *dones);
+    SNAKE_API snake_result snake_batch_get_score(const snake_batch *batch, size_t game, uint64_t *score);
+    /* width * height snake_cell bytes per game */
+    SNAKE_API size_t snake_batch_get_board_size(const snake_batch *batch);
+    SNAKE_API snake_result snake_batch_export_board(const snake_batch *batch, size_t game, uint8_t *buffer, size_t size);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SRC_CAPI_SNAKE_H */
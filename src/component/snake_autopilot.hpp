@@ -0,0 +1,9 @@
+#ifndef SRC_COMPONENT_SNAKE_AUTOPILOT_HPP
+#define SRC_COMPONENT_SNAKE_AUTOPILOT_HPP
+
+struct SnakeAutopilot
+{
+    bool isShortcutEnabled;
+}; // struct SnakeAutopilot
+
+#endif // SRC_COMPONENT_SNAKE_AUTOPILOT_HPP
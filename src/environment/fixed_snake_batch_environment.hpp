@@ -0,0 +1,245 @@
+#ifndef SRC_ENVIRONMENT_FIXED_SNAKE_BATCH_ENVIRONMENT_HPP
+#define SRC_ENVIRONMENT_FIXED_SNAKE_BATCH_ENVIRONMENT_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <environment/snake_environment.hpp>
+
+namespace FixedSnakeBoard
+{
+    static constexpr Sint16 WALL = -1;
+
+    template <int Width, int Height>
+    using NeighbourTable = std::array<std::array<Sint16, SnakeEnvironment::ACTION_END>, Width * Height>;
+
+    template <int Width>
+    constexpr Sint32 get_cell(const Sint32 &x, const Sint32 &y) { return y * Width + x; } // row 0 is the top row
+    template <int Width>
+    constexpr Sint32 get_x(const Sint32 &cell) { return cell % Width; }
+    template <int Width>
+    constexpr Sint32 get_y(const Sint32 &cell) { return cell / Width; }
+
+    // Cell reached from every cell by every action, WALL off the board; NONE stays put.
+    template <int Width, int Height>
+    constexpr NeighbourTable<Width, Height> make_neighbour_table()
+    {
+        NeighbourTable<Width, Height> ret{};
+        for (Sint32 cell = 0; cell < Width * Height; cell++)
+        {
+            const Sint32 x = get_x<Width>(cell);
+            const Sint32 y = get_y<Width>(cell);
+            ret[cell][SnakeEnvironment::NONE] = static_cast<Sint16>(cell);
+            ret[cell][SnakeEnvironment::UP] = y > 0 ? static_cast<Sint16>(get_cell<Width>(x, y - 1)) : WALL;
+            ret[cell][SnakeEnvironment::LEFT] = x > 0 ? static_cast<Sint16>(get_cell<Width>(x - 1, y)) : WALL;
+            ret[cell][SnakeEnvironment::DOWN] = y < Height - 1 ? static_cast<Sint16>(get_cell<Width>(x, y + 1)) : WALL;
+            ret[cell][SnakeEnvironment::RIGHT] = x < Width - 1 ? static_cast<Sint16>(get_cell<Width>(x + 1, y)) : WALL;
+        }
+        return ret;
+    }
+
+    static constexpr std::array<Uint8, SnakeEnvironment::ACTION_END> OPPOSITES = {
+        SnakeEnvironment::NONE, SnakeEnvironment::DOWN, SnakeEnvironment::RIGHT, SnakeEnvironment::UP, SnakeEnvironment::LEFT};
+} // namespace FixedSnakeBoard
+
+// SnakeBatchEnvironment with the board size fixed at compile time, for the
+// tournament sizes (see snake_headless). Moves are looked up in a constexpr
+// neighbour table instead of computed from x and y, per game boards are
+// std::arrays, and every modulo is by a constant. Given the same seed and
+// actions it produces exactly the same games as SnakeBatchEnvironment.
+template <int Width, int Height>
+class FixedSnakeBatchEnvironment
+{
+public:
+    static_assert(Width >= 2 && Height >= 1, "same limits as SnakeBatchEnvironment");
+    static_assert(Width * Height <= SDL_MAX_SINT16, "cells are stored as Sint16");
+
+    using Action = SnakeEnvironment::Action;
+    static constexpr Sint32 CELL_COUNT = Width * Height;
+    static constexpr FixedSnakeBoard::NeighbourTable<Width, Height> NEIGHBOURS = FixedSnakeBoard::make_neighbour_table<Width, Height>();
+
+    explicit FixedSnakeBatchEnvironment(const size_t &gameCount)
+        : gameCount(gameCount), headCell(gameCount), nextCell(gameCount), direction(gameCount), apple(gameCount),
+          length(gameCount), tailOffset(gameCount), rngState(gameCount), body(gameCount), occupancy(gameCount)
+    {
+        SDL_assert(gameCount >= 1);
+        reset(0U);
+    }
+
+    void reset(const Uint64 &seed)
+    {
+        for (size_t g = 0; g < gameCount; g++)
+        { // same sequences as SnakeBatchEnvironment::reset()
+            Uint64 z = seed + 0x9E3779B97F4A7C15ULL * (g + 1U);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            rngState[g] = z ^ (z >> 31);
+            reset_game(g);
+        }
+    }
+
+    // See SnakeBatchEnvironment::step().
+    void step(const Action *actions, float *rewards, Uint8 *dones)
+    {
+        SDL_assert(actions != nullptr && rewards != nullptr && dones != nullptr);
+
+        // Pass 1: new direction and next head cell.
+        for (size_t g = 0; g < gameCount; g++)
+        {
+            const Uint8 action = static_cast<Uint8>(actions[g]);
+            const Uint8 current = direction[g];
+            const bool isValid = action >= SnakeEnvironment::UP && action <= SnakeEnvironment::RIGHT;
+            const bool isBackwards = length[g] > 1 && action == FixedSnakeBoard::OPPOSITES[current];
+            const Uint8 next = (isValid && !isBackwards) ? action : current;
+            direction[g] = next;
+            nextCell[g] = NEIGHBOURS[headCell[g]][next];
+        }
+
+        // Pass 2: collisions, growth and apples.
+        for (size_t g = 0; g < gameCount; g++)
+        {
+            rewards[g] = 0.0f;
+            dones[g] = 0U;
+            const Sint16 cell = nextCell[g];
+            if (cell == FixedSnakeBoard::WALL)
+            {
+                finish_game(g, SnakeEnvironment::FAILURE_REWARD, rewards, dones);
+                continue;
+            }
+
+            std::array<Sint16, CELL_COUNT> &ring = body[g];
+            std::array<Uint8, CELL_COUNT> &occupied = occupancy[g];
+            const bool isEating = cell == apple[g];
+            if (!isEating)
+            { // tail moves out of the way before the head moves in
+                occupied[ring[tailOffset[g]]] = 0U;
+                tailOffset[g] = (tailOffset[g] + 1) % CELL_COUNT;
+                length[g]--;
+            }
+            if (occupied[cell])
+            {
+                finish_game(g, SnakeEnvironment::FAILURE_REWARD, rewards, dones);
+                continue;
+            }
+
+            ring[(tailOffset[g] + length[g]) % CELL_COUNT] = cell;
+            occupied[cell] = 1U;
+            length[g]++;
+            headCell[g] = cell;
+
+            if (isEating)
+            {
+                rewards[g] = SnakeEnvironment::APPLE_REWARD;
+                if (length[g] == CELL_COUNT)
+                {
+                    finish_game(g, SnakeEnvironment::APPLE_REWARD + SnakeEnvironment::SUCCESS_REWARD, rewards, dones);
+                    continue;
+                }
+                apple[g] = spawn_apple(g);
+            }
+        }
+    }
+
+    // See SnakeBatchEnvironment::observe().
+    void observe(Uint8 *buffer) const
+    {
+        SDL_assert(buffer != nullptr);
+        for (size_t g = 0; g < gameCount; g++)
+            observe(g, buffer + g * SnakeEnvironment::PLANE_COUNT * CELL_COUNT);
+    }
+    void observe(const size_t &game, Uint8 *buffer) const
+    {
+        SDL_assert(game < gameCount && buffer != nullptr);
+        Uint8 *const headPlane = buffer + SnakeEnvironment::HEAD_PLANE * CELL_COUNT;
+        Uint8 *const bodyPlane = buffer + SnakeEnvironment::BODY_PLANE * CELL_COUNT;
+        Uint8 *const applePlane = buffer + SnakeEnvironment::APPLE_PLANE * CELL_COUNT;
+        SDL_memset(headPlane, 0, CELL_COUNT);
+        SDL_memcpy(bodyPlane, occupancy[game].data(), CELL_COUNT);
+        SDL_memset(applePlane, 0, CELL_COUNT);
+        SDL_memset(buffer + SnakeEnvironment::OBSTACLE_PLANE * CELL_COUNT, 0, CELL_COUNT); // open board
+
+        bodyPlane[headCell[game]] = 0U;
+        headPlane[headCell[game]] = 1U;
+        if (apple[game] >= 0)
+            applePlane[apple[game]] = 1U;
+    }
+
+    // See SnakeBatchEnvironment::export_board().
+    void export_board(const size_t &game, Uint8 *buffer) const
+    {
+        SDL_assert(game < gameCount && buffer != nullptr);
+        const std::array<Uint8, CELL_COUNT> &occupied = occupancy[game];
+        for (Sint32 cell = 0; cell < CELL_COUNT; cell++)
+            buffer[cell] = occupied[cell] ? SnakeGameplaySystem::SNAKE_BODY : SnakeGameplaySystem::EMPTY;
+        buffer[headCell[game]] = SnakeGameplaySystem::SNAKE_HEAD;
+        if (apple[game] >= 0)
+            buffer[apple[game]] |= SnakeGameplaySystem::APPLE;
+    }
+
+    size_t get_game_count() const { return gameCount; }
+    size_t get_observation_size() const { return gameCount * SnakeEnvironment::PLANE_COUNT * CELL_COUNT; }
+    unsigned long get_score(const size_t &game) const { return static_cast<unsigned long>(length[game] - 1); }
+
+private:
+    void reset_game(const size_t &g)
+    { // same start as SnakeEnvironment::reset()
+        constexpr Sint16 START_CELL = static_cast<Sint16>(FixedSnakeBoard::get_cell<Width>(0, Height / 2));
+        constexpr Sint16 START_APPLE = static_cast<Sint16>(FixedSnakeBoard::get_cell<Width>(Width - 1, Height / 2));
+        occupancy[g].fill(0U);
+        headCell[g] = START_CELL;
+        direction[g] = SnakeEnvironment::RIGHT;
+        apple[g] = START_APPLE;
+        length[g] = 1;
+        tailOffset[g] = 0;
+        body[g][0] = START_CELL;
+        occupancy[g][START_CELL] = 1U;
+    }
+
+    void finish_game(const size_t &g, const float &reward, float *rewards, Uint8 *dones)
+    {
+        rewards[g] = reward;
+        dones[g] = 1U;
+        reset_game(g);
+    }
+
+    Sint16 spawn_apple(const size_t &g)
+    { // same draws as SnakeBatchEnvironment::spawn_apple()
+        const std::array<Uint8, CELL_COUNT> &occupied = occupancy[g];
+        const Sint32 freeCount = CELL_COUNT - length[g];
+        SDL_assert(freeCount > 0);
+        if (freeCount * 4 >= CELL_COUNT)
+        {
+            for (;;)
+            {
+                const Sint32 cell = SDL_rand_r(&rngState[g], CELL_COUNT);
+                if (!occupied[cell])
+                    return static_cast<Sint16>(cell);
+            }
+        }
+        Sint32 nth = SDL_rand_r(&rngState[g], freeCount);
+        for (Sint32 cell = 0; cell < CELL_COUNT; cell++)
+        {
+            if (!occupied[cell] && nth-- == 0)
+                return static_cast<Sint16>(cell);
+        }
+        return -1;
+    }
+
+    size_t gameCount;
+
+    std::vector<Sint16> headCell;
+    std::vector<Sint16> nextCell;
+    std::vector<Uint8> direction; // SnakeEnvironment::Action
+    std::vector<Sint16> apple;
+    std::vector<Sint32> length; // head included
+    std::vector<Sint32> tailOffset;
+    std::vector<Uint64> rngState;
+    std::vector<std::array<Sint16, CELL_COUNT>> body;     // per game ring, tail first
+    std::vector<std::array<Uint8, CELL_COUNT>> occupancy; // per game, head included
+}; // class FixedSnakeBatchEnvironment
+
+#endif // SRC_ENVIRONMENT_FIXED_SNAKE_BATCH_ENVIRONMENT_HPP
@@ -0,0 +1,329 @@
+#ifndef SRC_ENVIRONMENT_SNAKE_ARENA_ENVIRONMENT_HPP
+#define SRC_ENVIRONMENT_SNAKE_ARENA_ENVIRONMENT_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <environment/snake_environment.hpp>
+
+// Many snakes in one arena, moving one cell per step in lockstep, e.g. for
+// battle-royale matches of 64 to 512 snakes. Every snake has its own body
+// ring and action; all of them share one occupancy index (cell to owning
+// snake), so collisions are single lookups and a step costs O(snakes) no
+// matter the board size.
+//
+// A step moves every live snake at once: tails that do not grow move out of
+// the way first, then a head dies on a wall, on any body (its own included),
+// when two heads enter the same cell, or when two heads swap cells. A dead
+// snake's body is removed from the board. The match is over once at most one
+// snake is left alive (none for a single-snake arena) or a snake fills the board.
+//
+// NOTE: this is a discrete engine of its own, like SnakeBatchEnvironment, for
+// lockstep self-play; SnakeEnvironment runs several snakes on the ECS systems.
+class SnakeArenaEnvironment
+{
+public:
+    using Action = SnakeEnvironment::Action;
+
+    static constexpr size_t MAX_SNAKE_COUNT = SDL_MAX_UINT16 - 1U; // owners are stored as Uint16, 0 is free
+
+    struct Config
+    {
+        int width = 64;  // MUST BE >= 2
+        int height = 64; // MUST BE >= 1
+        size_t snakeCount = 64U;
+    }; // struct Config
+
+    // Where a snake starts, one cell long.
+    struct Spawn
+    {
+        Sint32 cell; // y * width + x
+        Action direction;
+    }; // struct Spawn
+
+    explicit SnakeArenaEnvironment(const Config &config)
+        : width(config.width), height(config.height), cellCount(config.width * config.height), snakeCount(config.snakeCount),
+          owners(cellCount), claimStamps(cellCount), claimSnakes(cellCount), headStamps(cellCount), headSnakes(cellCount),
+          bodies(config.snakeCount), headCell(config.snakeCount), nextCell(config.snakeCount), direction(config.snakeCount),
+          isAlive(config.snakeCount), isEating(config.snakeCount), isDying(config.snakeCount)
+    {
+        SDL_assert(config.width >= 2 && config.height >= 1);
+        SDL_assert(config.snakeCount >= 1U && config.snakeCount <= MAX_SNAKE_COUNT);
+        SDL_assert(config.snakeCount < static_cast<size_t>(cellCount)); // room for every snake and the apple
+        reset(0U);
+    }
+
+    // Places every snake, one cell long and facing a random direction, and the
+    // apple on random free cells.
+    void reset(const Uint64 &seed) { reset(seed, nullptr); }
+    // Same with the snakes at spawns[0 .. get_snake_count() - 1], e.g. for fair
+    // tournament starts; the cells MUST differ. Only the apple is random.
+    void reset(const Uint64 &seed, const Spawn *spawns)
+    {
+        Uint64 z = seed + 0x9E3779B97F4A7C15ULL; // splitmix64, see SnakeBatchEnvironment::reset()
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rngState = z ^ (z >> 31);
+
+        SDL_memset(owners.data(), 0, owners.size() * sizeof(Uint16));
+        occupiedCount = 0;
+        apple = -1;
+        aliveCount = snakeCount;
+        isFull = false;
+        for (size_t s = 0; s < snakeCount; s++)
+        {
+            const Sint32 cell = spawns != nullptr ? spawns[s].cell : spawn_cell();
+            SDL_assert(cell >= 0 && cell < cellCount && owners[cell] == 0U);
+            Body &body = bodies[s];
+            body.tailOffset = 0;
+            body.length = 0;
+            push_head(body, cell);
+            owners[cell] = static_cast<Uint16>(s + 1U);
+            occupiedCount++;
+            headCell[s] = cell;
+            direction[s] = spawns != nullptr ? static_cast<Uint8>(spawns[s].direction)
+                                             : static_cast<Uint8>(SnakeEnvironment::UP + SDL_rand_r(&rngState, 4));
+            isAlive[s] = 1U;
+        }
+        apple = spawn_cell();
+    }
+
+    // actions, rewards and dones MUST hold get_snake_count() entries each.
+    // dones[s] is 1 once snake s is dead; dead snakes ignore their action and
+    // get no reward. Call reset() once is_over().
+    void step(const Action *actions, float *rewards, Uint8 *dones)
+    {
+        SDL_assert(actions != nullptr && rewards != nullptr && dones != nullptr);
+        if (++stamp == 0U)
+        { // wrapped: forget every old stamp
+            SDL_memset(claimStamps.data(), 0, claimStamps.size() * sizeof(Uint32));
+            SDL_memset(headStamps.data(), 0, headStamps.size() * sizeof(Uint32));
+            stamp = 1U;
+        }
+
+        // Pass 1: new direction and next cell; claim the next cell and remember the current head.
+        for (size_t s = 0; s < snakeCount; s++)
+        {
+            rewards[s] = 0.0f;
+            isDying[s] = 0U;
+            if (!isAlive[s])
+                continue;
+            const Uint8 action = static_cast<Uint8>(actions[s]);
+            const Uint8 current = direction[s];
+            const Uint8 opposite = static_cast<Uint8>(current <= SnakeEnvironment::LEFT ? current + 2U : current - 2U);
+            const bool isValid = action >= SnakeEnvironment::UP && action <= SnakeEnvironment::RIGHT;
+            const bool isBackwards = bodies[s].length > 1 && action == opposite;
+            const Uint8 next = (isValid && !isBackwards) ? action : current;
+            direction[s] = next;
+
+            const Sint32 x = headCell[s] % width + (next == SnakeEnvironment::RIGHT) - (next == SnakeEnvironment::LEFT);
+            const Sint32 y = headCell[s] / width + (next == SnakeEnvironment::DOWN) - (next == SnakeEnvironment::UP);
+            headStamps[headCell[s]] = stamp;
+            headSnakes[headCell[s]] = static_cast<Uint16>(s);
+            if (x < 0 || x >= width || y < 0 || y >= height)
+            {
+                nextCell[s] = -1;
+                isDying[s] = 1U;
+                continue;
+            }
+            const Sint32 cell = y * width + x;
+            nextCell[s] = cell;
+            if (claimStamps[cell] == stamp)
+            { // head-to-head
+                isDying[s] = 1U;
+                isDying[claimSnakes[cell]] = 1U;
+            }
+            else
+            {
+                claimStamps[cell] = stamp;
+                claimSnakes[cell] = static_cast<Uint16>(s);
+            }
+        }
+
+        // Pass 2: tails that do not grow move out of the way before any head moves in.
+        for (size_t s = 0; s < snakeCount; s++)
+        {
+            if (!isAlive[s])
+                continue;
+            isEating[s] = nextCell[s] >= 0 && nextCell[s] == apple;
+            if (!isEating[s])
+            {
+                owners[pop_tail(bodies[s])] = 0U;
+                occupiedCount--;
+            }
+        }
+
+        // Pass 3: heads against bodies and heads swapping cells.
+        for (size_t s = 0; s < snakeCount; s++)
+        {
+            if (!isAlive[s] || isDying[s])
+                continue;
+            const Sint32 cell = nextCell[s];
+            if (owners[cell] != 0U)
+                isDying[s] = 1U;
+            else if (headStamps[cell] == stamp && nextCell[headSnakes[cell]] == headCell[s])
+                isDying[s] = 1U; // the other snake is marked from its own side
+        }
+
+        // Pass 4: remove the dead, move the living.
+        bool isAppleEaten = false;
+        for (size_t s = 0; s < snakeCount; s++)
+        {
+            if (!isAlive[s])
+                continue;
+            Body &body = bodies[s];
+            if (isDying[s])
+            {
+                while (body.length > 0)
+                {
+                    owners[pop_tail(body)] = 0U;
+                    occupiedCount--;
+                }
+                isAlive[s] = 0U;
+                aliveCount--;
+                rewards[s] = SnakeEnvironment::FAILURE_REWARD;
+                continue;
+            }
+            const Sint32 cell = nextCell[s];
+            push_head(body, cell);
+            owners[cell] = static_cast<Uint16>(s + 1U);
+            occupiedCount++;
+            headCell[s] = cell;
+            if (isEating[s])
+            {
+                rewards[s] = SnakeEnvironment::APPLE_REWARD;
+                isAppleEaten = true;
+            }
+        }
+
+        if (isAppleEaten)
+        {
+            if (occupiedCount == cellCount)
+            { // full board: every snake still alive wins
+                apple = -1;
+                isFull = true;
+                for (size_t s = 0; s < snakeCount; s++)
+                    rewards[s] += isAlive[s] ? SnakeEnvironment::SUCCESS_REWARD : 0.0f;
+            }
+            else
+            { // the eaten cell now holds a head, so it MUST NOT be excluded twice
+                apple = -1;
+                apple = spawn_cell();
+            }
+        }
+        for (size_t s = 0; s < snakeCount; s++)
+            dones[s] = isAlive[s] ? 0U : 1U;
+    }
+
+    // Writes height * width MapSlotState bytes, row 0 at the top, see SnakeGameplaySystem::get_board().
+    void export_board(Uint8 *buffer) const
+    {
+        SDL_assert(buffer != nullptr);
+        for (Sint32 cell = 0; cell < cellCount; cell++)
+            buffer[cell] = owners[cell] != 0U ? SnakeGameplaySystem::SNAKE_BODY : SnakeGameplaySystem::EMPTY;
+        for (size_t s = 0; s < snakeCount; s++)
+        {
+            if (isAlive[s])
+                buffer[headCell[s]] = SnakeGameplaySystem::SNAKE_HEAD;
+        }
+        if (apple >= 0)
+            buffer[apple] |= SnakeGameplaySystem::APPLE;
+    }
+
+    bool is_over() const { return isFull || aliveCount == 0U || (snakeCount > 1U && aliveCount <= 1U); }
+    size_t get_snake_count() const { return snakeCount; }
+    size_t get_alive_count() const { return aliveCount; }
+    bool is_alive(const size_t &snake) const { return isAlive[snake] != 0U; }
+    Sint32 get_length(const size_t &snake) const { return bodies[snake].length; }
+    Sint32 get_head_cell(const size_t &snake) const { return headCell[snake]; } // y * width + x, last cell for a dead snake
+    Sint32 get_apple_cell() const { return apple; }                            // -1 once the board is full
+    Sint32 get_owner(const Sint32 &cell) const { return static_cast<Sint32>(owners[cell]) - 1; } // -1 if free
+    Sint32 get_occupied_count() const { return occupiedCount; }
+
+private:
+    // Ring of cells, tail first, with a power-of-two capacity that only grows.
+    struct Body
+    {
+        std::vector<Sint32> cells;
+        Sint32 tailOffset = 0;
+        Sint32 length = 0;
+    }; // struct Body
+
+    static void push_head(Body &body, const Sint32 &cell)
+    {
+        const Sint32 capacity = static_cast<Sint32>(body.cells.size());
+        if (body.length == capacity)
+        { // linearise into twice the room
+            std::vector<Sint32> cells(capacity > 0 ? 2 * capacity : 8);
+            for (Sint32 i = 0; i < body.length; i++)
+                cells[i] = body.cells[(body.tailOffset + i) & (capacity - 1)];
+            body.cells.swap(cells);
+            body.tailOffset = 0;
+        }
+        body.cells[(body.tailOffset + body.length) & (static_cast<Sint32>(body.cells.size()) - 1)] = cell;
+        body.length++;
+    }
+
+    static Sint32 pop_tail(Body &body)
+    {
+        SDL_assert(body.length > 0);
+        const Sint32 cell = body.cells[body.tailOffset];
+        body.tailOffset = (body.tailOffset + 1) & (static_cast<Sint32>(body.cells.size()) - 1);
+        body.length--;
+        return cell;
+    }
+
+    // Uniform over the cells no snake owns; apple MUST be -1 here.
+    Sint32 spawn_cell()
+    { // see SnakeBatchEnvironment::spawn_apple()
+        SDL_assert(apple < 0);
+        const Sint32 freeCount = cellCount - occupiedCount;
+        SDL_assert(freeCount > 0);
+        if (freeCount * 4 >= cellCount)
+        {
+            for (;;)
+            {
+                const Sint32 cell = SDL_rand_r(&rngState, cellCount);
+                if (owners[cell] == 0U)
+                    return cell;
+            }
+        }
+        Sint32 nth = SDL_rand_r(&rngState, freeCount);
+        for (Sint32 cell = 0; cell < cellCount; cell++)
+        {
+            if (owners[cell] == 0U && nth-- == 0)
+                return cell;
+        }
+        return -1;
+    }
+
+    Sint32 width;
+    Sint32 height;
+    Sint32 cellCount;
+    size_t snakeCount;
+
+    std::vector<Uint16> owners; // per cell, snake index + 1, 0 if free
+    std::vector<Uint32> claimStamps; // per cell, == stamp if a head moves in this step
+    std::vector<Uint16> claimSnakes;
+    std::vector<Uint32> headStamps; // per cell, == stamp if a head leaves it this step
+    std::vector<Uint16> headSnakes;
+    Uint32 stamp = 0U;
+
+    std::vector<Body> bodies;
+    std::vector<Sint32> headCell;
+    std::vector<Sint32> nextCell; // -1 off the board
+    std::vector<Uint8> direction; // SnakeEnvironment::Action
+    std::vector<Uint8> isAlive;
+    std::vector<Uint8> isEating;
+    std::vector<Uint8> isDying;
+    size_t aliveCount = 0U;
+    Sint32 occupiedCount = 0;
+    Sint32 apple = -1;
+    bool isFull = false;
+    Uint64 rngState = 0U;
+}; // class SnakeArenaEnvironment
+
+#endif // SRC_ENVIRONMENT_SNAKE_ARENA_ENVIRONMENT_HPP
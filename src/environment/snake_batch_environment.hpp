@@ -0,0 +1,225 @@
+#ifndef SRC_ENVIRONMENT_SNAKE_BATCH_ENVIRONMENT_HPP
+#define SRC_ENVIRONMENT_SNAKE_BATCH_ENVIRONMENT_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <environment/snake_environment.hpp>
+
+// Steps N games in lockstep, one cell per step, with every game stored in
+// structure-of-arrays form instead of its own registry. Follows the rules of
+// SnakeGameplaySystem: reversing into the neck is ignored, the tail moves out of
+// the way before the head, eating grows the snake and the game is won once the
+// snake fills the board. Finished games are reset in the same step().
+class SnakeBatchEnvironment
+{
+public:
+    using Action = SnakeEnvironment::Action;
+    using Config = SnakeEnvironment::Config; // speed and tickPeriodMs are unused, a step is always one cell
+
+    explicit SnakeBatchEnvironment(const size_t &gameCount, const Config &config)
+        : gameCount(gameCount), width(config.width), height(config.height), cellCount(config.width * config.height),
+          headX(gameCount), headY(gameCount), nextX(gameCount), nextY(gameCount),
+          direction(gameCount), apple(gameCount), length(gameCount), tailOffset(gameCount),
+          rngState(gameCount), body(gameCount * cellCount), occupancy(gameCount * cellCount)
+    {
+        SDL_assert(gameCount >= 1);
+        SDL_assert(config.width >= 2 && config.height >= 1);
+        reset(0U);
+    }
+
+    void reset(const Uint64 &seed)
+    {
+        for (size_t g = 0; g < gameCount; g++)
+        {
+            // splitmix64 so that neighbouring games get unrelated sequences
+            Uint64 z = seed + 0x9E3779B97F4A7C15ULL * (g + 1U);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            rngState[g] = z ^ (z >> 31);
+            reset_game(g);
+        }
+    }
+
+    // actions, rewards and dones MUST hold get_game_count() entries each.
+    // rewards and dones describe the step that was just taken; a game reported
+    // as done has already been reset for the next call.
+    void step(const Action *actions, float *rewards, Uint8 *dones)
+    {
+        SDL_assert(actions != nullptr && rewards != nullptr && dones != nullptr);
+
+        // Pass 1: new direction and next head cell, branch-free over contiguous arrays.
+        Uint8 *const dirs = direction.data();
+        const Sint32 *const lengths = length.data();
+        const Sint32 *const hx = headX.data();
+        const Sint32 *const hy = headY.data();
+        Sint32 *const nx = nextX.data();
+        Sint32 *const ny = nextY.data();
+        for (size_t g = 0; g < gameCount; g++)
+        {
+            const Uint8 action = static_cast<Uint8>(actions[g]);
+            const Uint8 current = dirs[g];
+            const Uint8 opposite = static_cast<Uint8>(current <= SnakeEnvironment::LEFT ? current + 2U : current - 2U);
+            const bool isValid = action >= SnakeEnvironment::UP && action <= SnakeEnvironment::RIGHT;
+            const bool isBackwards = lengths[g] > 1 && action == opposite;
+            const Uint8 next = (isValid && !isBackwards) ? action : current;
+            dirs[g] = next;
+            nx[g] = hx[g] + (next == SnakeEnvironment::RIGHT) - (next == SnakeEnvironment::LEFT);
+            ny[g] = hy[g] + (next == SnakeEnvironment::DOWN) - (next == SnakeEnvironment::UP);
+        }
+
+        // Pass 2: collisions, growth and apples; each game only touches its own slice.
+        for (size_t g = 0; g < gameCount; g++)
+        {
+            rewards[g] = 0.0f;
+            dones[g] = 0U;
+            if (nx[g] < 0 || nx[g] >= width || ny[g] < 0 || ny[g] >= height)
+            {
+                finish_game(g, SnakeEnvironment::FAILURE_REWARD, rewards, dones);
+                continue;
+            }
+
+            Sint32 *const ring = body.data() + g * cellCount;
+            Uint8 *const occupied = occupancy.data() + g * cellCount;
+            const Sint32 nextCell = ny[g] * width + nx[g];
+            const bool isEating = nextCell == apple[g];
+            if (!isEating)
+            { // tail moves out of the way before the head moves in
+                occupied[ring[tailOffset[g]]] = 0U;
+                tailOffset[g] = (tailOffset[g] + 1) % cellCount;
+                length[g]--;
+            }
+            if (occupied[nextCell])
+            {
+                finish_game(g, SnakeEnvironment::FAILURE_REWARD, rewards, dones);
+                continue;
+            }
+
+            ring[(tailOffset[g] + length[g]) % cellCount] = nextCell;
+            occupied[nextCell] = 1U;
+            length[g]++;
+            headX[g] = nx[g];
+            headY[g] = ny[g];
+
+            if (isEating)
+            {
+                rewards[g] = SnakeEnvironment::APPLE_REWARD;
+                if (length[g] == cellCount)
+                {
+                    finish_game(g, SnakeEnvironment::APPLE_REWARD + SnakeEnvironment::SUCCESS_REWARD, rewards, dones);
+                    continue;
+                }
+                apple[g] = spawn_apple(g);
+            }
+        }
+    }
+
+    // Writes get_game_count() observations back to back, each laid out like
+    // SnakeEnvironment::observe(), into a buffer of get_observation_size() bytes.
+    void observe(Uint8 *buffer) const
+    {
+        SDL_assert(buffer != nullptr);
+        for (size_t g = 0; g < gameCount; g++)
+            observe(g, buffer + g * SnakeEnvironment::PLANE_COUNT * cellCount);
+    }
+    void observe(const size_t &game, Uint8 *buffer) const
+    {
+        SDL_assert(game < gameCount && buffer != nullptr);
+        Uint8 *const headPlane = buffer + SnakeEnvironment::HEAD_PLANE * cellCount;
+        Uint8 *const bodyPlane = buffer + SnakeEnvironment::BODY_PLANE * cellCount;
+        Uint8 *const applePlane = buffer + SnakeEnvironment::APPLE_PLANE * cellCount;
+        SDL_memset(headPlane, 0, cellCount);
+        SDL_memcpy(bodyPlane, occupancy.data() + game * cellCount, cellCount);
+        SDL_memset(applePlane, 0, cellCount);
+        SDL_memset(buffer + SnakeEnvironment::OBSTACLE_PLANE * cellCount, 0, cellCount); // open board
+
+        const Sint32 headCell = headY[game] * width + headX[game];
+        bodyPlane[headCell] = 0U;
+        headPlane[headCell] = 1U;
+        if (apple[game] >= 0)
+            applePlane[apple[game]] = 1U;
+    }
+
+    // Writes height * width SnakeGameplaySystem::MapSlotState bytes of one game, like SnakeEnvironment::export_board().
+    void export_board(const size_t &game, Uint8 *buffer) const
+    {
+        SDL_assert(game < gameCount && buffer != nullptr);
+        const Uint8 *const occupied = occupancy.data() + game * cellCount;
+        for (Sint32 cell = 0; cell < cellCount; cell++)
+            buffer[cell] = occupied[cell] ? SnakeGameplaySystem::SNAKE_BODY : SnakeGameplaySystem::EMPTY;
+        buffer[headY[game] * width + headX[game]] = SnakeGameplaySystem::SNAKE_HEAD;
+        if (apple[game] >= 0)
+            buffer[apple[game]] |= SnakeGameplaySystem::APPLE;
+    }
+
+    size_t get_game_count() const { return gameCount; }
+    size_t get_observation_size() const { return gameCount * SnakeEnvironment::PLANE_COUNT * cellCount; }
+    unsigned long get_score(const size_t &game) const { return static_cast<unsigned long>(length[game] - 1); }
+
+private:
+    void reset_game(const size_t &g)
+    { // same start as SnakeEnvironment::reset()
+        SDL_memset(occupancy.data() + g * cellCount, 0, cellCount);
+        const Sint32 row = height / 2;
+        headX[g] = 0;
+        headY[g] = row;
+        direction[g] = SnakeEnvironment::RIGHT;
+        apple[g] = row * width + width - 1;
+        length[g] = 1;
+        tailOffset[g] = 0;
+        body[g * cellCount] = row * width;
+        occupancy[g * cellCount + row * width] = 1U;
+    }
+
+    void finish_game(const size_t &g, const float &reward, float *rewards, Uint8 *dones)
+    {
+        rewards[g] = reward;
+        dones[g] = 1U;
+        reset_game(g);
+    }
+
+    Sint32 spawn_apple(const size_t &g)
+    { // rejection sampling stays O(1) expected until the board is mostly full
+        const Uint8 *const occupied = occupancy.data() + g * cellCount;
+        const Sint32 freeCount = cellCount - length[g];
+        SDL_assert(freeCount > 0);
+        if (freeCount * 4 >= cellCount)
+        {
+            for (;;)
+            {
+                const Sint32 cell = SDL_rand_r(&rngState[g], cellCount);
+                if (!occupied[cell])
+                    return cell;
+            }
+        }
+        Sint32 nth = SDL_rand_r(&rngState[g], freeCount);
+        for (Sint32 cell = 0; cell < cellCount; cell++)
+        {
+            if (!occupied[cell] && nth-- == 0)
+                return cell;
+        }
+        return -1;
+    }
+
+    size_t gameCount;
+    Sint32 width;
+    Sint32 height;
+    Sint32 cellCount;
+
+    std::vector<Sint32> headX;
+    std::vector<Sint32> headY;
+    std::vector<Sint32> nextX;
+    std::vector<Sint32> nextY;
+    std::vector<Uint8> direction; // SnakeEnvironment::Action
+    std::vector<Sint32> apple;    // i * width + j
+    std::vector<Sint32> length;   // head included
+    std::vector<Sint32> tailOffset;
+    std::vector<Uint64> rngState;
+    std::vector<Sint32> body;     // per game ring of cellCount cells, tail first
+    std::vector<Uint8> occupancy; // per game cellCount cells, head included
+}; // class SnakeBatchEnvironment
+
+#endif // SRC_ENVIRONMENT_SNAKE_BATCH_ENVIRONMENT_HPP
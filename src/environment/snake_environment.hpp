@@ -0,0 +1,345 @@
+#ifndef SRC_ENVIRONMENT_SNAKE_ENVIRONMENT_HPP
+#define SRC_ENVIRONMENT_SNAKE_ENVIRONMENT_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+#include <entt/entt.hpp>
+
+#include <component/delta_time.hpp>
+#include <component/key_control.hpp>
+#include <component/position.hpp>
+#include <component/snake_apple.hpp>
+#include <component/snake_boundary_2d.hpp>
+#include <component/snake_part.hpp>
+#include <component/snake_part_head.hpp>
+#include <component/velocity.hpp>
+
+#include <system/system_pipeline.hpp>
+#include <system/translate_2d.hpp>
+#include <system/snake_gameplay_system.hpp>
+
+// Headless step/reset interface over the gameplay systems for training agents.
+// Every instance owns its registry, gameplay state and random stream, so instances can
+// be stepped in any interleaving, or from different threads one instance per thread.
+// Config::snakeCount snakes share the board, each steered by its own action.
+class SnakeEnvironment
+{
+public:
+    enum Action : Uint8
+    {
+        NONE = 0U, // keep the current direction
+        UP,
+        LEFT,
+        DOWN,
+        RIGHT,
+
+        ACTION_END,
+    }; // enum Action
+
+    enum ObservationPlane : Uint8
+    {
+        HEAD_PLANE = 0U,
+        BODY_PLANE,
+        APPLE_PLANE,
+        OBSTACLE_PLANE, // the level's blocked cells, see load_obstacles()
+
+        PLANE_COUNT,
+    }; // enum ObservationPlane
+
+    struct Config
+    {
+        int width = 20;  // MUST BE >= 2
+        int height = 20; // MUST BE >= 1
+        float speed = 2.0f;
+        Uint64 tickPeriodMs = 125U; // speed * tickPeriodMs MUST BE <= 500.0f, see Global::TICK_UNIT_TRAVELLED
+        int snakeCount = 1; // MUST BE >= 1 and <= height, one row each
+    }; // struct Config
+
+    struct StepResult
+    {
+        float reward;
+        bool done;
+    }; // struct StepResult
+
+    static constexpr float APPLE_REWARD = 1.0f;
+    static constexpr float SUCCESS_REWARD = 10.0f;
+    static constexpr float FAILURE_REWARD = -1.0f;
+
+    explicit SnakeEnvironment(const Config &config) : config(config)
+    {
+        SDL_assert(config.width >= 2 && config.height >= 1);
+        SDL_assert(config.speed * static_cast<float>(config.tickPeriodMs) <= 500.0f);
+        SDL_assert(config.snakeCount >= 1 && config.snakeCount <= config.height);
+        snakeHeads.resize(static_cast<size_t>(config.snakeCount));
+        scores.resize(static_cast<size_t>(config.snakeCount));
+        takenCells.reserve(2U * static_cast<size_t>(config.snakeCount));
+        previousCells.resize(2U * static_cast<size_t>(config.snakeCount));
+        isRunning.resize(static_cast<size_t>(config.snakeCount));
+        const float unitPerTick = config.speed * static_cast<float>(config.tickPeriodMs) / 1000.0f;
+        maxTicksPerStep = (unitPerTick > 0.0f) ? static_cast<long>(SDL_ceilf(1.0f / unitPerTick)) + 2L : 1L;
+        reset(0U);
+    }
+
+    void reset(const Uint64 &seed) // seed 0 picks a time-based seed
+    {
+        reg.clear(); // keeps the capacity reserved below, so a reset SHOULD NOT allocate, see allocation_test
+        SnakeGameplaySystem::reserve(reg, {config.width, config.height}, static_cast<size_t>(config.snakeCount));
+        auto gameStateEntity = reg.create();
+        reg.emplace<DeltaTime>(gameStateEntity, config.tickPeriodMs);
+        reg.emplace<KeyControl>(gameStateEntity, 'd', false);
+        reg.emplace<SnakeBoundary2D>(gameStateEntity, config.width, config.height);
+
+        // each head on the left of its row facing an apple on the right, the rows spread over
+        // the board (the middle one for a single snake), or the open cells nearest to those
+        // on a level
+        const SnakeBoundary2D boundary{config.width, config.height};
+        takenCells.clear();
+        for (int k = 0; k < config.snakeCount; k++)
+        {
+            const long row = static_cast<long>(config.height) * (k + 1) / (config.snakeCount + 1);
+            const long appleCell = SnakeGameplaySystem::find_open_cell(reg, boundary, row * config.width + config.width - 1, takenCells.data(), takenCells.size());
+            takenCells.push_back(appleCell);
+            const long headCell = SnakeGameplaySystem::find_open_cell(reg, boundary, row * config.width, takenCells.data(), takenCells.size());
+            takenCells.push_back(headCell);
+            SDL_assert(appleCell >= 0 && headCell >= 0); // see load_obstacles()
+            auto appleEntity = reg.create();
+            reg.emplace<Position>(appleEntity, SnakeGameplaySystem::Util::get_pos_from_index(appleCell % config.width, appleCell / config.width, config.height));
+            reg.emplace<SnakeApple>(appleEntity);
+
+            const entt::entity snakeHeadEntity = reg.create();
+            reg.emplace<Position>(snakeHeadEntity, SnakeGameplaySystem::Util::get_pos_from_index(headCell % config.width, headCell / config.width, config.height));
+            reg.emplace<Velocity>(snakeHeadEntity, 0.0f, 0.0f);
+            reg.emplace<SnakePartHead>(snakeHeadEntity, config.speed, 1.0f);
+            if (config.snakeCount > 1)
+                reg.emplace<KeyControl>(snakeHeadEntity, 'd', false);
+            snakeHeads[k] = snakeHeadEntity;
+            scores[k] = 0UL;
+        }
+
+        SnakeGameplaySystem::seed(reg, seed);
+        SnakeGameplaySystem::init(reg);
+        score = 0UL;
+        isDone = false;
+        isSuccess = false;
+    }
+
+    // Blocks the cells where mask (height * width bytes, row 0 at the top) is non-zero,
+    // from the next reset() on; nullptr opens the board again. At least two cells MUST
+    // stay open, one for the head and one for an apple.
+    void load_obstacles(const Uint8 *mask) { SnakeGameplaySystem::load_obstacles(reg, {config.width, config.height}, mask); }
+    // Same with a level drawn as text, see SnakeGameplaySystem::parse_level(); false, and the
+    // obstacles left as they were, if the text does not fit the board.
+    bool load_level(const char *text, const size_t &length)
+    {
+        std::vector<Uint8> mask;
+        if (!SnakeGameplaySystem::parse_level(text, length, {config.width, config.height}, mask))
+            return false;
+        load_obstacles(mask.data());
+        return true;
+    }
+
+    // Advances the game until the head enters the next cell (or the game ends). With several
+    // snakes, every one of them takes the action; the reward and done are the whole board's.
+    StepResult step(const Action &action)
+    {
+        if (isDone)
+            return StepResult{0.0f, true};
+
+        switch (action)
+        {
+        case UP:
+            SnakeGameplaySystem::Control::up_key_down(reg);
+            break;
+        case LEFT:
+            SnakeGameplaySystem::Control::left_key_down(reg);
+            break;
+        case DOWN:
+            SnakeGameplaySystem::Control::down_key_down(reg);
+            break;
+        case RIGHT:
+            SnakeGameplaySystem::Control::right_key_down(reg);
+            break;
+        default:
+            break;
+        }
+        advance();
+
+        StepResult ret{0.0f, false};
+        const unsigned long currentScore = SnakeGameplaySystem::get_score(reg);
+        if (currentScore > score)
+            ret.reward += APPLE_REWARD * static_cast<float>(currentScore - score);
+        score = currentScore;
+        for (size_t k = 0; k < snakeHeads.size(); k++)
+            scores[k] = SDL_max(scores[k], SnakeGameplaySystem::get_score(reg, snakeHeads[k]));
+
+        if (SnakeGameplaySystem::is_game_failure(reg))
+        {
+            ret.reward += FAILURE_REWARD;
+            isDone = true;
+        }
+        else if (SnakeGameplaySystem::is_game_success(reg))
+        {
+            ret.reward += SUCCESS_REWARD;
+            isDone = true;
+            isSuccess = true;
+        }
+        ret.done = isDone;
+        return ret;
+    }
+    // Same with one action per snake, actions and results holding get_snake_count() entries.
+    // Snake k is rewarded for its own apples and its own crash, and is done once it crashed
+    // (its body then leaves the board) or the game is over.
+    void step(const Action *actions, StepResult *results)
+    {
+        SDL_assert(actions != nullptr && results != nullptr);
+        for (size_t k = 0; k < snakeHeads.size(); k++)
+        {
+            results[k] = StepResult{0.0f, true};
+            if (isDone || SnakeGameplaySystem::is_snake_failure(reg, snakeHeads[k]))
+                continue;
+            switch (actions[k])
+            {
+            case UP:
+                SnakeGameplaySystem::Control::up_key_down(reg, snakeHeads[k]);
+                break;
+            case LEFT:
+                SnakeGameplaySystem::Control::left_key_down(reg, snakeHeads[k]);
+                break;
+            case DOWN:
+                SnakeGameplaySystem::Control::down_key_down(reg, snakeHeads[k]);
+                break;
+            case RIGHT:
+                SnakeGameplaySystem::Control::right_key_down(reg, snakeHeads[k]);
+                break;
+            default:
+                break;
+            }
+            results[k].done = false;
+        }
+        if (isDone)
+            return;
+        advance();
+
+        const bool isFailure = SnakeGameplaySystem::is_game_failure(reg);
+        isSuccess = !isFailure && SnakeGameplaySystem::is_game_success(reg);
+        isDone = isFailure || isSuccess;
+        score = SnakeGameplaySystem::get_score(reg);
+        for (size_t k = 0; k < snakeHeads.size(); k++)
+        {
+            if (results[k].done)
+                continue; // crashed in an earlier step
+            const unsigned long currentScore = SnakeGameplaySystem::get_score(reg, snakeHeads[k]);
+            if (currentScore > scores[k])
+            {
+                results[k].reward += APPLE_REWARD * static_cast<float>(currentScore - scores[k]);
+                scores[k] = currentScore;
+            }
+            if (SnakeGameplaySystem::is_snake_failure(reg, snakeHeads[k]))
+            {
+                results[k].reward += FAILURE_REWARD;
+                results[k].done = true;
+            }
+            else if (isSuccess)
+                results[k].reward += SUCCESS_REWARD;
+            results[k].done = results[k].done || isDone;
+        }
+    }
+
+    // Writes PLANE_COUNT planes of height * width bytes (row 0 is the top row, like get_map())
+    // into a caller-owned buffer of at least get_observation_size() bytes.
+    void observe(Uint8 *buffer) const
+    {
+        SDL_assert(buffer != nullptr);
+        const size_t planeSize = static_cast<size_t>(config.width) * static_cast<size_t>(config.height);
+        SDL_memset(buffer, 0, planeSize * PLANE_COUNT);
+
+        auto mark = [&](const ObservationPlane &plane, const Position &pos)
+        {
+            long x, y;
+            SnakeGameplaySystem::Util::get_index_from_pos(pos, &x, &y, config.height);
+            if (x >= 0 && y >= 0 && x < config.width && y < config.height)
+                buffer[plane * planeSize + static_cast<size_t>(y) * config.width + static_cast<size_t>(x)] = 1U;
+        };
+
+        auto snakeHeadView = reg.view<SnakePartHead, Position>();
+        for (auto &entity : snakeHeadView)
+            mark(HEAD_PLANE, snakeHeadView.get<Position>(entity));
+        auto snakePartView = reg.view<SnakePart, Position>();
+        for (auto &entity : snakePartView)
+            mark(BODY_PLANE, snakePartView.get<Position>(entity));
+        auto appleView = reg.view<SnakeApple, Position>();
+        for (auto &entity : appleView)
+            mark(APPLE_PLANE, appleView.get<Position>(entity));
+        if (const SnakeGameplaySystem::ObstacleLayer *obstacles = SnakeGameplaySystem::find_obstacles(reg))
+        {
+            for (size_t cell = 0; cell < planeSize; cell++)
+                buffer[OBSTACLE_PLANE * planeSize + cell] = obstacles->is_blocked(static_cast<long>(cell)) ? 1U : 0U;
+        }
+    }
+
+    // Writes height * width SnakeGameplaySystem::MapSlotState bytes, the same values as get_map().
+    void export_board(Uint8 *buffer) const { SnakeGameplaySystem::get_board(reg, buffer); }
+
+    size_t get_observation_size() const { return static_cast<size_t>(config.width) * static_cast<size_t>(config.height) * PLANE_COUNT; }
+    unsigned long get_score() const { return score; }
+    unsigned long get_score(const size_t &snake) const { return scores[snake]; } // its longest body
+    size_t get_snake_count() const { return snakeHeads.size(); }
+    entt::entity get_snake_head(const size_t &snake) const { return snakeHeads[snake]; } // invalid once it crashed
+    bool is_done() const { return isDone; }
+    bool is_success() const { return isSuccess; }
+    const Config &get_config() const { return config; }
+    entt::registry &get_registry() { return reg; }
+
+private:
+    using Pipeline = SystemPipeline<SystemTranslate2D::iterate, SnakeGameplaySystem::iterate>; // same order as Global::GameplayPipeline, no autopilot
+
+    // Runs ticks until every head still running entered its next cell or crashed, or the game
+    // ends. Heads crossing into a row below do so a tick later than the others, see floor().
+    void advance()
+    {
+        size_t runningCount = 0U;
+        for (size_t k = 0; k < snakeHeads.size(); k++)
+        {
+            isRunning[k] = !SnakeGameplaySystem::is_snake_failure(reg, snakeHeads[k]);
+            if (!isRunning[k])
+                continue;
+            SnakeGameplaySystem::Util::get_index_from_pos(reg.get<Position>(snakeHeads[k]), &previousCells[2U * k], &previousCells[2U * k + 1U], config.height);
+            runningCount++;
+        }
+        SDL_assert(runningCount > 0U);
+        for (long tick = 0; tick < maxTicksPerStep && runningCount > 0U; tick++)
+        {
+            Pipeline::iterate(reg);
+            for (size_t k = 0; k < snakeHeads.size(); k++)
+            {
+                if (!isRunning[k])
+                    continue;
+                long x = previousCells[2U * k], y = previousCells[2U * k + 1U];
+                if (reg.valid(snakeHeads[k])) // else crashed and taken off the board
+                    SnakeGameplaySystem::Util::get_index_from_pos(reg.get<Position>(snakeHeads[k]), &x, &y, config.height);
+                if (!reg.valid(snakeHeads[k]) || x != previousCells[2U * k] || y != previousCells[2U * k + 1U])
+                {
+                    isRunning[k] = false;
+                    runningCount--;
+                }
+            }
+        }
+    }
+
+    Config config;
+    entt::registry reg;
+    std::vector<entt::entity> snakeHeads; // one per snake, in the rows' order
+    std::vector<unsigned long> scores;
+    std::vector<long> takenCells;    // scratch of reset()
+    std::vector<long> previousCells; // scratch of advance(), x and y of each head
+    std::vector<bool> isRunning;     // scratch of advance()
+    long maxTicksPerStep;
+    unsigned long score;
+    bool isDone;
+    bool isSuccess;
+}; // class SnakeEnvironment
+
+#endif // SRC_ENVIRONMENT_SNAKE_ENVIRONMENT_HPP
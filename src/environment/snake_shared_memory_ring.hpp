@@ -0,0 +1,289 @@
+#ifndef SRC_ENVIRONMENT_SNAKE_SHARED_MEMORY_RING_HPP
+#define SRC_ENVIRONMENT_SNAKE_SHARED_MEMORY_RING_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SNAKE_HAS_SHARED_MEMORY_RING 1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <environment/snake_environment.hpp>
+
+// POSIX shared-memory ring through which a headless runner publishes every
+// step of a SnakeBatchEnvironment (observation planes, scores and done flags)
+// and reads back the actions of one out-of-process consumer. Slots and the
+// action block are guarded by sequence counters (seqlocks): the producer never
+// waits for a consumer, and a consumer detects torn reads by re-checking the
+// counter after reading the slot in place.
+class SnakeSharedMemoryRing
+{
+public:
+    static constexpr Uint32 MAGIC = 0x534E4B52U; // "SNKR"
+    static constexpr Uint32 VERSION = 2U; // 2: four observation planes, with SnakeEnvironment::OBSTACLE_PLANE
+    static constexpr size_t ALIGNMENT = 64U; // keeps counters on their own cache lines
+
+    struct Header
+    {
+        std::atomic<Uint32> magic; // MAGIC, stored last by create() so attach() never sees a half-written header
+        Uint32 version;
+        Uint32 gameCount;
+        Uint32 width;
+        Uint32 height;
+        Uint32 slotCount;
+        Uint64 slotSize;           // bytes per slot, counter included
+        Uint64 observationsOffset; // from the start of a slot, after the counter, scores and dones
+        alignas(ALIGNMENT) std::atomic<Uint64> publishedCount;
+        alignas(ALIGNMENT) std::atomic<Uint64> actionSequence; // odd while the consumer writes actions
+    }; // struct Header
+
+    struct SlotView
+    {
+        Uint8 *observations; // gameCount * SnakeEnvironment::PLANE_COUNT * width * height bytes
+        Uint32 *scores;      // gameCount entries
+        Uint8 *dones;        // gameCount entries
+    }; // struct SlotView
+
+    static_assert(std::atomic<Uint32>::is_always_lock_free && std::atomic<Uint64>::is_always_lock_free,
+                  "shared counters must be address-free");
+
+    SnakeSharedMemoryRing() = default;
+    SnakeSharedMemoryRing(const SnakeSharedMemoryRing &) = delete;
+    SnakeSharedMemoryRing &operator=(const SnakeSharedMemoryRing &) = delete;
+    ~SnakeSharedMemoryRing() { close(); }
+
+    // Producer side; name follows shm_open(), e.g. "/snake_ring".
+    bool create(const char *name, const Uint32 &gameCount, const Uint32 &width, const Uint32 &height, const Uint32 &slotCount)
+    {
+        SDL_assert(name != nullptr && gameCount > 0U && width > 0U && height > 0U && slotCount > 0U);
+        close();
+        Uint64 observationsOffset, slotSize, totalSize;
+        if (!get_layout(gameCount, width, height, slotCount, &observationsOffset, &slotSize, &totalSize) || totalSize > SIZE_MAX)
+            return false;
+        const size_t size = static_cast<size_t>(totalSize);
+
+        const int fd = shm_open(name, O_CREAT | O_RDWR | O_TRUNC, 0600);
+        if (fd < 0)
+            return false;
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0 || !map(fd, size))
+        {
+            ::close(fd);
+            shm_unlink(name);
+            return false;
+        }
+        ::close(fd);
+        isOwner = true;
+        shmName = name;
+
+        Header *header = new (base) Header();
+        header->version = VERSION;
+        header->gameCount = gameCount;
+        header->width = width;
+        header->height = height;
+        header->slotCount = slotCount;
+        header->slotSize = slotSize;
+        header->observationsOffset = observationsOffset;
+        for (Uint32 i = 0; i < slotCount; i++)
+            new (get_slot_base(i)) std::atomic<Uint64>(0U);
+        header->publishedCount.store(0U, std::memory_order_relaxed);
+        header->actionSequence.store(0U, std::memory_order_relaxed);
+        header->magic.store(MAGIC, std::memory_order_release); // publishes every field above
+        return true;
+    }
+
+    // Consumer side.
+    bool attach(const char *name)
+    {
+        SDL_assert(name != nullptr);
+        close();
+        const int fd = shm_open(name, O_RDWR, 0600);
+        if (fd < 0)
+            return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < 0 || static_cast<Uint64>(info.st_size) < align(sizeof(Header)) ||
+            !map(fd, static_cast<size_t>(info.st_size)))
+        {
+            ::close(fd);
+            return false;
+        }
+        ::close(fd);
+        const Header *header = get_header();
+        if (header->magic.load(std::memory_order_acquire) != MAGIC || header->version != VERSION)
+        {
+            close();
+            return false;
+        }
+        // The header decides where every slot is, so it MUST describe this very
+        // mapping before a slot is touched; a short segment would fault (SIGBUS).
+        Uint64 observationsOffset, slotSize, totalSize;
+        if (header->gameCount == 0U || header->width == 0U || header->height == 0U || header->slotCount == 0U ||
+            !get_layout(header->gameCount, header->width, header->height, header->slotCount, &observationsOffset, &slotSize, &totalSize) ||
+            header->observationsOffset != observationsOffset || header->slotSize != slotSize || totalSize > mappedSize)
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close()
+    {
+        if (base != nullptr)
+            munmap(base, mappedSize);
+        if (isOwner)
+            shm_unlink(shmName.c_str());
+        base = nullptr;
+        mappedSize = 0U;
+        isOwner = false;
+        shmName.clear();
+        lastActionSequence = 0U;
+    }
+
+    bool is_open() const { return base != nullptr; }
+    const Header *get_header() const { return static_cast<const Header *>(base); }
+
+    // Producer: fill the returned view in place (e.g. SnakeBatchEnvironment::observe(view.observations)),
+    // then call end_publish().
+    SlotView begin_publish()
+    {
+        SDL_assert(isOwner);
+        Header *header = get_header_mutable();
+        const Uint64 count = header->publishedCount.load(std::memory_order_relaxed) + 1U;
+        Uint8 *slot = get_slot_base((count - 1U) % header->slotCount);
+        get_slot_sequence(slot).store(2U * count - 1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return get_slot_view(slot);
+    }
+    void end_publish()
+    {
+        Header *header = get_header_mutable();
+        const Uint64 count = header->publishedCount.load(std::memory_order_relaxed) + 1U;
+        Uint8 *slot = get_slot_base((count - 1U) % header->slotCount);
+        get_slot_sequence(slot).store(2U * count, std::memory_order_release);
+        header->publishedCount.store(count, std::memory_order_release);
+    }
+
+    // Producer: copies the newest complete action block; false if it is torn,
+    // being written or was already read, in which case actions is left as is.
+    bool read_actions(Uint8 *actions)
+    {
+        SDL_assert(actions != nullptr);
+        const Header *header = get_header();
+        const Uint64 before = header->actionSequence.load(std::memory_order_acquire);
+        if (before % 2U != 0U || before == lastActionSequence)
+            return false;
+        scratchActions.resize(header->gameCount);
+        SDL_memcpy(scratchActions.data(), get_action_base(), header->gameCount);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->actionSequence.load(std::memory_order_relaxed) != before)
+            return false;
+        SDL_memcpy(actions, scratchActions.data(), header->gameCount);
+        lastActionSequence = before;
+        return true;
+    }
+
+    // Consumer: the newest published step, 0 if none.
+    Uint64 get_published_count() const { return get_header()->publishedCount.load(std::memory_order_acquire); }
+
+    // Consumer: zero-copy view of step `count` (1-based). Read it, then confirm with
+    // is_slot_valid(count); false from either call means the producer lapped the reader.
+    bool peek(const Uint64 &count, SlotView *view) const
+    {
+        SDL_assert(view != nullptr);
+        if (count == 0U || !is_slot_valid(count))
+            return false;
+        *view = get_slot_view(get_slot_base((count - 1U) % get_header()->slotCount));
+        return true;
+    }
+    bool is_slot_valid(const Uint64 &count) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        Uint8 *slot = get_slot_base((count - 1U) % get_header()->slotCount);
+        return get_slot_sequence(slot).load(std::memory_order_acquire) == 2U * count;
+    }
+
+    // Consumer: only one process may write actions.
+    void write_actions(const Uint8 *actions)
+    {
+        SDL_assert(actions != nullptr);
+        Header *header = get_header_mutable();
+        const Uint64 sequence = header->actionSequence.load(std::memory_order_relaxed);
+        header->actionSequence.store(sequence + 1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        SDL_memcpy(get_action_base(), actions, header->gameCount);
+        header->actionSequence.store(sequence + 2U, std::memory_order_release);
+    }
+
+private:
+    static Uint64 align(const Uint64 &size) { return (size + ALIGNMENT - 1U) / ALIGNMENT * ALIGNMENT; }
+
+    // Where a slot's observations start, the bytes per slot and per segment; false
+    // if they do not fit in 64 bits, e.g. for a corrupt header.
+    static bool get_layout(const Uint32 &gameCount, const Uint32 &width, const Uint32 &height, const Uint32 &slotCount,
+                           Uint64 *observationsOffset, Uint64 *slotSize, Uint64 *totalSize)
+    {
+        static constexpr Uint64 LIMIT = SDL_MAX_UINT64 / 2U; // room for the offsets and the rounding up
+        const Uint64 planeCount = static_cast<Uint64>(gameCount) * SnakeEnvironment::PLANE_COUNT;
+        const Uint64 cellCount = static_cast<Uint64>(width) * height;
+        if (planeCount == 0U || slotCount == 0U || cellCount > LIMIT / planeCount)
+            return false;
+        const Uint64 observationsSize = planeCount * cellCount;
+        *observationsOffset = align(ALIGNMENT + static_cast<Uint64>(gameCount) * sizeof(Uint32) + gameCount);
+        *slotSize = align(*observationsOffset + observationsSize);
+        if (*slotSize > LIMIT / slotCount)
+            return false;
+        *totalSize = align(sizeof(Header)) + *slotSize * slotCount + align(gameCount);
+        return true;
+    }
+
+    bool map(const int &fd, const size_t &size)
+    {
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (ptr == MAP_FAILED)
+            return false;
+        base = ptr;
+        mappedSize = size;
+        return true;
+    }
+
+    Header *get_header_mutable() { return static_cast<Header *>(base); }
+    Uint8 *get_slot_base(const Uint64 &index) const
+    {
+        return static_cast<Uint8 *>(base) + align(sizeof(Header)) + get_header()->slotSize * index;
+    }
+    Uint8 *get_action_base() const
+    {
+        return static_cast<Uint8 *>(base) + align(sizeof(Header)) + get_header()->slotSize * get_header()->slotCount;
+    }
+    static std::atomic<Uint64> &get_slot_sequence(Uint8 *slot) { return *reinterpret_cast<std::atomic<Uint64> *>(slot); }
+    SlotView get_slot_view(Uint8 *slot) const
+    {
+        SlotView ret;
+        ret.scores = reinterpret_cast<Uint32 *>(slot + ALIGNMENT);
+        ret.dones = reinterpret_cast<Uint8 *>(ret.scores + get_header()->gameCount);
+        ret.observations = slot + get_header()->observationsOffset;
+        return ret;
+    }
+
+    void *base = nullptr;
+    size_t mappedSize = 0U;
+    bool isOwner = false;
+    std::string shmName;
+    std::vector<Uint8> scratchActions;
+    Uint64 lastActionSequence = 0U;
+}; // class SnakeSharedMemoryRing
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // SRC_ENVIRONMENT_SNAKE_SHARED_MEMORY_RING_HPP
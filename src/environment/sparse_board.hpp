@@ -0,0 +1,282 @@
+#ifndef SRC_ENVIRONMENT_SPARSE_BOARD_HPP
+#define SRC_ENVIRONMENT_SPARSE_BOARD_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+
+// Occupancy of a board far too large to store densely, e.g. 10000 x 10000.
+// The board is cut into TILE_SIZE x TILE_SIZE tiles; a tile is a bitmask that
+// exists while one of its cells is occupied, so memory follows the area the
+// snakes cover at once instead of the board area. Tiles are found through an
+// open-addressing table of tile keys; a tile that empties out drops its key
+// and goes onto a free list, and the next tile to be occupied, wherever it
+// is, reuses it. Only growing past the most tiles ever occupied at once
+// allocates (see reserve()).
+class SparseBoard
+{
+public:
+    static constexpr Sint32 TILE_SHIFT = 6;
+    static constexpr Sint32 TILE_SIZE = 1 << TILE_SHIFT; // also the bits of a tile row
+    static constexpr int MAX_SAMPLE_ATTEMPTS = 64;        // before sample_free_cell() counts its way to a cell
+    static constexpr size_t DEFAULT_TILE_CAPACITY = 8U;
+
+    SparseBoard(const Sint32 &width, const Sint32 &height)
+        : width(width), height(height), tileColumnCount((width + TILE_SIZE - 1) >> TILE_SHIFT),
+          tileRowCount((height + TILE_SIZE - 1) >> TILE_SHIFT)
+    {
+        SDL_assert(width >= 1 && height >= 1);
+        reserve(DEFAULT_TILE_CAPACITY);
+    }
+
+    // Makes room for tileCount tiles occupied at once, so occupy() does not allocate until then.
+    void reserve(const size_t &tileCount)
+    {
+        tiles.reserve(tileCount);
+        freeTiles.reserve(tileCount);
+        size_t slotCount = 2U * DEFAULT_TILE_CAPACITY;
+        while (slotCount < 2U * tileCount) // load factor at most 1/2
+            slotCount *= 2U;
+        if (slotCount > slots.size())
+            rehash(slotCount);
+    }
+
+    Sint32 get_width() const { return width; }
+    Sint32 get_height() const { return height; }
+    Sint64 get_cell_count() const { return static_cast<Sint64>(width) * height; }
+    Sint64 get_occupied_count() const { return occupiedCount; }
+    size_t get_tile_count() const { return occupiedTileCount; } // tiles with an occupied cell
+    size_t get_allocated_tile_count() const { return tiles.size(); } // the most tiles ever occupied at once
+
+    bool is_occupied(const Sint32 &x, const Sint32 &y) const
+    {
+        SDL_assert(is_inside(x, y));
+        const Tile *tile = find_tile(get_tile_key(x >> TILE_SHIFT, y >> TILE_SHIFT));
+        return tile != nullptr && (tile->rows[y & (TILE_SIZE - 1)] >> (x & (TILE_SIZE - 1)) & 1U);
+    }
+
+    bool is_inside(const Sint32 &x, const Sint32 &y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+
+    // The cell MUST be free.
+    void occupy(const Sint32 &x, const Sint32 &y)
+    {
+        SDL_assert(is_inside(x, y));
+        Tile &tile = tiles[get_or_add_tile(get_tile_key(x >> TILE_SHIFT, y >> TILE_SHIFT))];
+        Uint64 &row = tile.rows[y & (TILE_SIZE - 1)];
+        const Uint64 bit = Uint64{1U} << (x & (TILE_SIZE - 1));
+        SDL_assert(!(row & bit));
+        row |= bit;
+        occupiedTileCount += tile.count == 0U;
+        tile.count++;
+        occupiedCount++;
+    }
+
+    // The cell MUST be occupied.
+    void release(const Sint32 &x, const Sint32 &y)
+    {
+        SDL_assert(is_inside(x, y));
+        const Uint64 key = get_tile_key(x >> TILE_SHIFT, y >> TILE_SHIFT);
+        const size_t slot = find_slot(key);
+        SDL_assert(slots[slot].key == key);
+        Tile &tile = tiles[slots[slot].tile];
+        Uint64 &row = tile.rows[y & (TILE_SIZE - 1)];
+        const Uint64 bit = Uint64{1U} << (x & (TILE_SIZE - 1));
+        SDL_assert(row & bit);
+        row &= ~bit;
+        tile.count--;
+        occupiedCount--;
+        if (tile.count == 0U)
+        { // every row zero, ready for reuse
+            occupiedTileCount--;
+            remove_slot(slot);
+        }
+    }
+
+    // Frees every cell; the tiles go onto the free list.
+    void clear()
+    {
+        for (Slot &slot : slots)
+        {
+            if (slot.key == EMPTY_KEY)
+                continue;
+            tiles[slot.tile].rows.fill(0U);
+            tiles[slot.tile].count = 0U;
+            freeTiles.push_back(slot.tile);
+            slot.key = EMPTY_KEY;
+        }
+        occupiedCount = 0;
+        occupiedTileCount = 0U;
+    }
+
+    // Picks a free cell uniformly at random; false if the board is full. Draws
+    // random cells and skips full tiles without looking at their bits, so the
+    // expected cost is O(1) while a good share of the board is free.
+    bool sample_free_cell(Uint64 *rngState, Sint32 *x, Sint32 *y) const
+    {
+        SDL_assert(rngState != nullptr && x != nullptr && y != nullptr);
+        const Sint64 freeCount = get_cell_count() - occupiedCount;
+        if (freeCount <= 0)
+            return false;
+
+        for (int attempt = 0; attempt < MAX_SAMPLE_ATTEMPTS; attempt++)
+        {
+            const Sint32 cellX = SDL_rand_r(rngState, width);
+            const Sint32 cellY = SDL_rand_r(rngState, height);
+            const Tile *tile = find_tile(get_tile_key(cellX >> TILE_SHIFT, cellY >> TILE_SHIFT));
+            if (tile != nullptr && (tile->count == get_tile_area(cellX >> TILE_SHIFT, cellY >> TILE_SHIFT) ||
+                                    (tile->rows[cellY & (TILE_SIZE - 1)] >> (cellX & (TILE_SIZE - 1)) & 1U)))
+                continue;
+            *x = cellX;
+            *y = cellY;
+            return true;
+        }
+
+        // Mostly full: pick the nth free cell, skipping whole tiles by their counts.
+        const Uint64 random = (static_cast<Uint64>(SDL_rand_bits_r(rngState)) << 32) | SDL_rand_bits_r(rngState);
+        Sint64 nth = static_cast<Sint64>(random % static_cast<Uint64>(freeCount));
+        for (Sint32 tileY = 0; tileY < tileRowCount; tileY++)
+        {
+            for (Sint32 tileX = 0; tileX < tileColumnCount; tileX++)
+            {
+                const Tile *tile = find_tile(get_tile_key(tileX, tileY));
+                const Sint64 tileFreeCount = static_cast<Sint64>(get_tile_area(tileX, tileY)) - (tile != nullptr ? tile->count : 0U);
+                if (nth >= tileFreeCount)
+                {
+                    nth -= tileFreeCount;
+                    continue;
+                }
+                const Sint32 rowEnd = SDL_min(TILE_SIZE, height - (tileY << TILE_SHIFT));
+                const Sint32 columnEnd = SDL_min(TILE_SIZE, width - (tileX << TILE_SHIFT));
+                for (Sint32 row = 0; row < rowEnd; row++)
+                {
+                    for (Sint32 column = 0; column < columnEnd; column++)
+                    {
+                        if ((tile != nullptr && (tile->rows[row] >> column & 1U)) || nth-- != 0)
+                            continue;
+                        *x = (tileX << TILE_SHIFT) + column;
+                        *y = (tileY << TILE_SHIFT) + row;
+                        return true;
+                    }
+                }
+            }
+        }
+        SDL_assert(false); // occupiedCount out of sync with the tiles
+        return false;
+    }
+
+private:
+    struct Tile
+    {
+        std::array<Uint64, TILE_SIZE> rows{}; // bit x of rows[y] is cell (x, y) of the tile
+        Uint32 count = 0U;
+    }; // struct Tile
+
+    struct Slot
+    {
+        Uint64 key;
+        Uint32 tile; // index in tiles
+    }; // struct Slot
+
+    static constexpr Uint64 EMPTY_KEY = SDL_MAX_UINT64; // tile coordinates are never negative
+
+    static Uint64 get_tile_key(const Sint32 &tileX, const Sint32 &tileY)
+    {
+        return (static_cast<Uint64>(static_cast<Uint32>(tileY)) << 32) | static_cast<Uint32>(tileX);
+    }
+
+    size_t get_home_slot(const Uint64 &key) const
+    { // Fibonacci hashing
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & (slots.size() - 1U);
+    }
+
+    // Linear probing from the key's home slot: its own slot, or the empty one where it would go.
+    size_t find_slot(const Uint64 &key) const
+    {
+        const size_t mask = slots.size() - 1U;
+        size_t slot = get_home_slot(key);
+        while (slots[slot].key != key && slots[slot].key != EMPTY_KEY)
+            slot = (slot + 1U) & mask;
+        return slot;
+    }
+
+    const Tile *find_tile(const Uint64 &key) const
+    {
+        const Slot &slot = slots[find_slot(key)];
+        return slot.key == key ? &tiles[slot.tile] : nullptr;
+    }
+
+    Uint32 get_or_add_tile(const Uint64 &key)
+    {
+        size_t slot = find_slot(key);
+        if (slots[slot].key == key)
+            return slots[slot].tile;
+        if (2U * (occupiedTileCount + 1U) > slots.size())
+        {
+            rehash(2U * slots.size());
+            slot = find_slot(key);
+        }
+        if (freeTiles.empty())
+        {
+            slots[slot] = Slot{key, static_cast<Uint32>(tiles.size())};
+            tiles.emplace_back();
+            freeTiles.reserve(tiles.capacity()); // room for every tile, so release() and clear() do not allocate
+        }
+        else
+        {
+            slots[slot] = Slot{key, freeTiles.back()};
+            freeTiles.pop_back();
+        }
+        return slots[slot].tile;
+    }
+
+    // Backward-shift deletion, so probing needs no tombstones.
+    void remove_slot(size_t slot)
+    {
+        const size_t mask = slots.size() - 1U;
+        freeTiles.push_back(slots[slot].tile);
+        for (size_t next = (slot + 1U) & mask; slots[next].key != EMPTY_KEY; next = (next + 1U) & mask)
+        {
+            const size_t home = get_home_slot(slots[next].key);
+            if (((next - home) & mask) >= ((next - slot) & mask))
+            { // the hole lies on next's probe path
+                slots[slot] = slots[next];
+                slot = next;
+            }
+        }
+        slots[slot].key = EMPTY_KEY;
+    }
+
+    void rehash(const size_t &slotCount)
+    {
+        std::vector<Slot> oldSlots(slotCount, Slot{EMPTY_KEY, 0U});
+        slots.swap(oldSlots);
+        for (const Slot &slot : oldSlots)
+        {
+            if (slot.key != EMPTY_KEY)
+                slots[find_slot(slot.key)] = slot;
+        }
+    }
+
+    Uint32 get_tile_area(const Sint32 &tileX, const Sint32 &tileY) const
+    { // edge tiles are cut by the board
+        const Sint32 tileWidth = SDL_min(TILE_SIZE, width - (tileX << TILE_SHIFT));
+        const Sint32 tileHeight = SDL_min(TILE_SIZE, height - (tileY << TILE_SHIFT));
+        return static_cast<Uint32>(tileWidth * tileHeight);
+    }
+
+    Sint32 width;
+    Sint32 height;
+    Sint32 tileColumnCount;
+    Sint32 tileRowCount;
+    Sint64 occupiedCount = 0;
+    size_t occupiedTileCount = 0U;
+
+    std::vector<Slot> slots; // open-addressing table of the occupied tiles, a power-of-two size
+    std::vector<Tile> tiles; // occupied or free
+    std::vector<Uint32> freeTiles;
+}; // class SparseBoard
+
+#endif // SRC_ENVIRONMENT_SPARSE_BOARD_HPP
@@ -0,0 +1,131 @@
+#ifndef SRC_ENVIRONMENT_SPARSE_SNAKE_ENVIRONMENT_HPP
+#define SRC_ENVIRONMENT_SPARSE_SNAKE_ENVIRONMENT_HPP
+
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <environment/snake_environment.hpp>
+#include <environment/sparse_board.hpp>
+
+// One game on a huge arena, e.g. 10000 x 10000, following the rules of
+// SnakeBatchEnvironment. Occupancy lives in a SparseBoard and the body in a
+// ring of cells, so memory grows with the snake rather than with the board,
+// and apples are placed by SparseBoard::sample_free_cell(). There are no
+// observation planes: read the cells around the head with is_occupied().
+class SparseSnakeEnvironment
+{
+public:
+    using Action = SnakeEnvironment::Action;
+    using StepResult = SnakeEnvironment::StepResult;
+
+    struct Cell
+    {
+        Sint32 x;
+        Sint32 y;
+    }; // struct Cell
+
+    SparseSnakeEnvironment(const Sint32 &width, const Sint32 &height) : board(width, height)
+    {
+        SDL_assert(width >= 2 && height >= 1);
+        reset(0U);
+    }
+
+    void reset(const Uint64 &seed)
+    { // same start as SnakeEnvironment::reset()
+        Uint64 z = seed + 0x9E3779B97F4A7C15ULL; // splitmix64, see SnakeBatchEnvironment::reset()
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rngState = z ^ (z >> 31);
+
+        board.clear();
+        bodyTailOffset = 0U;
+        bodyLength = 0U;
+        const Sint32 row = board.get_height() / 2;
+        push_head({0, row});
+        board.occupy(0, row);
+        direction = SnakeEnvironment::RIGHT;
+        apple = {board.get_width() - 1, row};
+        isDone = false;
+    }
+
+    // Moves the head by one cell; see SnakeBatchEnvironment::step(). A finished
+    // game stays done until reset().
+    StepResult step(const Action &action)
+    {
+        if (isDone)
+            return StepResult{0.0f, true};
+
+        const Uint8 opposite = static_cast<Uint8>(direction <= SnakeEnvironment::LEFT ? direction + 2U : direction - 2U);
+        const bool isValid = action >= SnakeEnvironment::UP && action <= SnakeEnvironment::RIGHT;
+        if (isValid && !(bodyLength > 1U && action == opposite))
+            direction = action;
+
+        const Cell head = get_head();
+        const Cell next = {head.x + (direction == SnakeEnvironment::RIGHT) - (direction == SnakeEnvironment::LEFT),
+                           head.y + (direction == SnakeEnvironment::DOWN) - (direction == SnakeEnvironment::UP)};
+        if (!board.is_inside(next.x, next.y))
+            return finish(SnakeEnvironment::FAILURE_REWARD);
+
+        const bool isEating = next.x == apple.x && next.y == apple.y;
+        if (!isEating)
+        { // tail moves out of the way before the head moves in
+            const Cell &tail = body[bodyTailOffset];
+            board.release(tail.x, tail.y);
+            bodyTailOffset = (bodyTailOffset + 1U) & (body.size() - 1U);
+            bodyLength--;
+        }
+        if (board.is_occupied(next.x, next.y))
+            return finish(SnakeEnvironment::FAILURE_REWARD);
+        board.occupy(next.x, next.y);
+        push_head(next);
+
+        if (!isEating)
+            return StepResult{0.0f, false};
+        if (!board.sample_free_cell(&rngState, &apple.x, &apple.y))
+            return finish(SnakeEnvironment::APPLE_REWARD + SnakeEnvironment::SUCCESS_REWARD);
+        return StepResult{SnakeEnvironment::APPLE_REWARD, false};
+    }
+
+    const SparseBoard &get_board() const { return board; }
+    bool is_occupied(const Sint32 &x, const Sint32 &y) const { return board.is_occupied(x, y); } // head included
+    Cell get_head() const { return body[(bodyTailOffset + bodyLength - 1U) & (body.size() - 1U)]; }
+    Cell get_apple() const { return apple; }
+    Action get_direction() const { return direction; }
+    bool is_done() const { return isDone; }
+    unsigned long get_score() const { return static_cast<unsigned long>(bodyLength - 1U); }
+
+private:
+    // See SnakeArenaEnvironment::push_head().
+    void push_head(const Cell &cell)
+    {
+        if (bodyLength == body.size())
+        { // linearise into twice the room
+            std::vector<Cell> cells(!body.empty() ? 2U * body.size() : 8U);
+            for (size_t i = 0; i < bodyLength; i++)
+                cells[i] = body[(bodyTailOffset + i) & (body.size() - 1U)];
+            body.swap(cells);
+            bodyTailOffset = 0U;
+        }
+        body[(bodyTailOffset + bodyLength) & (body.size() - 1U)] = cell;
+        bodyLength++;
+    }
+
+    StepResult finish(const float &reward)
+    {
+        isDone = true;
+        return StepResult{reward, true};
+    }
+
+    SparseBoard board;
+    std::vector<Cell> body; // ring, tail first, with a power-of-two capacity that only grows
+    size_t bodyTailOffset = 0U;
+    size_t bodyLength = 0U;
+    Action direction = SnakeEnvironment::RIGHT;
+    Cell apple = {0, 0};
+    Uint64 rngState = 0U;
+    bool isDone = false;
+}; // class SparseSnakeEnvironment
+
+#endif // SRC_ENVIRONMENT_SPARSE_SNAKE_ENVIRONMENT_HPP
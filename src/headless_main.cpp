@@ -0,0 +1,191 @@
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+#include <environment/fixed_snake_batch_environment.hpp>
+#include <environment/snake_batch_environment.hpp>
+#include <environment/snake_shared_memory_ring.hpp>
+#include <render/terminal_renderer.hpp>
+
+namespace Global
+{
+    static constexpr Uint32 SHARED_MEMORY_SLOT_COUNT = 8U;
+    static volatile std::sig_atomic_t isStopRequested = 0; // set by SIGINT / SIGTERM
+} // namespace Global
+
+// Ends the step loop instead of killing the process, so that run() returns and
+// the shared memory segment is unlinked on the way out.
+static void request_stop(int)
+{
+    Global::isStopRequested = 1;
+}
+
+struct RunnerOptions
+{
+    size_t gameCount = 64U;
+    int width = 20;
+    int height = 20;
+    long steps = 100000L; // <= 0 runs until SIGINT or SIGTERM
+    Uint64 seed = 1U;
+    const char *sharedMemoryName = nullptr;
+    bool isWatching = false; // draws game 0 on the terminal after every step
+    Uint32 stepDelayMs = 0U;
+};
+
+static void print_usage(const char *program)
+{
+    std::cerr << "Usage: " << program << " [--games N] [--width W] [--height H] [--steps S] [--seed X] [--shm /name] [--watch] [--step-ms T]" << std::endl;
+}
+
+static bool parse_options(int argc, char **argv, RunnerOptions *options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--games") == 0 && hasValue)
+            options->gameCount = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--width") == 0 && hasValue)
+            options->width = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--height") == 0 && hasValue)
+            options->height = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--steps") == 0 && hasValue)
+            options->steps = std::atol(argv[++i]);
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+            options->seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--shm") == 0 && hasValue)
+            options->sharedMemoryName = argv[++i];
+        else if (std::strcmp(argv[i], "--watch") == 0)
+            options->isWatching = true;
+        else if (std::strcmp(argv[i], "--step-ms") == 0 && hasValue)
+            options->stepDelayMs = static_cast<Uint32>(std::strtoul(argv[++i], nullptr, 10));
+        else
+            return false;
+    }
+    return options->gameCount >= 1U && options->width >= 2 && options->height >= 1;
+}
+
+// Batch is SnakeBatchEnvironment or one of the FixedSnakeBatchEnvironment sizes.
+template <typename Batch>
+static int run(const RunnerOptions &options, Batch &batch)
+{
+    batch.reset(options.seed);
+
+    std::vector<SnakeEnvironment::Action> actions(options.gameCount, SnakeEnvironment::NONE);
+    std::vector<Uint8> actionBytes(options.gameCount, SnakeEnvironment::NONE);
+    std::vector<float> rewards(options.gameCount);
+    std::vector<Uint8> dones(options.gameCount);
+    std::vector<Uint8> watchedBoard(options.isWatching ? static_cast<size_t>(options.width) * static_cast<size_t>(options.height) : 0U);
+    TerminalRenderer terminalRenderer;
+
+#ifdef SNAKE_HAS_SHARED_MEMORY_RING
+    SnakeSharedMemoryRing ring;
+    if (options.sharedMemoryName != nullptr &&
+        !ring.create(options.sharedMemoryName, static_cast<Uint32>(options.gameCount), options.width, options.height, Global::SHARED_MEMORY_SLOT_COUNT))
+    {
+        std::cerr << "shm_open error: " << std::strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+#else
+    if (options.sharedMemoryName != nullptr)
+    {
+        std::cerr << "--shm is not supported on this platform" << std::endl;
+        return EXIT_FAILURE;
+    }
+#endif
+
+    Uint64 policyState = options.seed;
+    unsigned long gamesFinished = 0UL;
+    const Uint64 start = SDL_GetTicksNS();
+    long step = 0;
+    for (; (options.steps <= 0 || step < options.steps) && !Global::isStopRequested; step++)
+    {
+#ifdef SNAKE_HAS_SHARED_MEMORY_RING
+        if (ring.is_open())
+        {
+            if (ring.read_actions(actionBytes.data())) // otherwise keep the previous actions; never wait
+            {
+                for (size_t g = 0; g < options.gameCount; g++)
+                    actions[g] = static_cast<SnakeEnvironment::Action>(actionBytes[g] < SnakeEnvironment::ACTION_END ? actionBytes[g] : SnakeEnvironment::NONE);
+            }
+        }
+        else
+#endif
+        { // random policy, mostly going straight
+            for (size_t g = 0; g < options.gameCount; g++)
+            {
+                const Sint32 choice = SDL_rand_r(&policyState, 2 * SnakeEnvironment::ACTION_END);
+                actions[g] = static_cast<SnakeEnvironment::Action>(choice < SnakeEnvironment::ACTION_END ? choice : SnakeEnvironment::NONE);
+            }
+        }
+
+        batch.step(actions.data(), rewards.data(), dones.data());
+
+#ifdef SNAKE_HAS_SHARED_MEMORY_RING
+        if (ring.is_open())
+        {
+            SnakeSharedMemoryRing::SlotView view = ring.begin_publish();
+            batch.observe(view.observations);
+            for (size_t g = 0; g < options.gameCount; g++)
+                view.scores[g] = static_cast<Uint32>(batch.get_score(g));
+            SDL_memcpy(view.dones, dones.data(), options.gameCount);
+            ring.end_publish();
+        }
+#endif
+        for (size_t g = 0; g < options.gameCount; g++)
+            gamesFinished += dones[g];
+
+        if (options.isWatching)
+        {
+            char statusText[96];
+            std::snprintf(statusText, sizeof(statusText), "step %ld  score %lu  games finished %lu",
+                          step, batch.get_score(0U), gamesFinished);
+            batch.export_board(0U, watchedBoard.data());
+            terminalRenderer.draw(watchedBoard.data(), options.width, options.height, statusText);
+            terminalRenderer.present(stdout);
+        }
+        if (options.stepDelayMs > 0U)
+            SDL_Delay(options.stepDelayMs);
+    }
+    if (options.isWatching)
+        terminalRenderer.restore(stdout);
+
+    const double seconds = static_cast<double>(SDL_GetTicksNS() - start) / static_cast<double>(SDL_NS_PER_SECOND);
+    const double totalSteps = static_cast<double>(step) * static_cast<double>(options.gameCount);
+    std::cout << step << " steps of " << options.gameCount << " games in " << seconds << " s ("
+              << (seconds > 0.0 ? totalSteps / seconds : 0.0) << " game steps/s), "
+              << gamesFinished << " games finished" << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+    RunnerOptions options;
+    if (!parse_options(argc, argv, &options))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+
+    // Tournament sizes get the compile-time engine, every other size the runtime one.
+    if (options.width == 20 && options.height == 20)
+    {
+        FixedSnakeBatchEnvironment<20, 20> batch(options.gameCount);
+        return run(options, batch);
+    }
+    if (options.width == 32 && options.height == 32)
+    {
+        FixedSnakeBatchEnvironment<32, 32> batch(options.gameCount);
+        return run(options, batch);
+    }
+    SnakeBatchEnvironment batch(options.gameCount, {options.width, options.height});
+    return run(options, batch);
+}
@@ -1,21 +1,39 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <entt/entt.hpp>
-#include <sigslot/signal.hpp>
 #include <SDL3/SDL.h>
 
 #include <component/delta_time.hpp>
 #include <component/key_control.hpp>
 #include <component/position.hpp>
 #include <component/snake_apple.hpp>
+#include <component/snake_autopilot.hpp>
 #include <component/snake_boundary_2d.hpp>
 #include <component/snake_part_head.hpp>
 #include <component/snake_part.hpp>
 #include <component/velocity.hpp>
 
+#include <system/system_pipeline.hpp>
 #include <system/translate_2d.hpp>
 #include <system/snake_gameplay_system.hpp>
+#include <system/snake_hamiltonian_solver.hpp>
+
+#include <profiler/allocation_counter.hpp>
+#include <profiler/frame_stats.hpp>
+#include <profiler/input_latency_tracker.hpp>
+#include <profiler/tick_profiler.hpp>
+#include <profiler/trace_recorder.hpp>
+
+#include <render/board_snapshot.hpp>
+#include <render/frame_encoder.hpp>
+#include <render/triple_buffer.hpp>
 
 #include "component/delta_time.hpp"
 #include "component/key_control.hpp"
@@ -23,11 +41,45 @@
 #define SDL_MAIN_USE_CALLBACKS
 #include <SDL3/SDL_main.h>
 
+#ifdef SNAKE_ENABLE_PROFILER
+SNAKE_DEFINE_COUNTING_OPERATOR_NEW(); // feeds the bytes allocated per tick of the performance HUD
+#endif // SNAKE_ENABLE_PROFILER
+
+// What render_gameplay_visuals() derives from the window size, the score and the game
+// state. It is rebuilt only when one of those changes, not on every frame.
+struct RenderState
+{
+    enum Status : Uint8
+    {
+        PLAYING = 0U,
+        PAUSED,
+        SUCCESS,
+        FAILURE,
+    }; // enum Status
+
+    static constexpr int STATUS_TEXT_MAX_LENGTH = 80; // characters, longest message plus a 20-digit score
+
+    // Invalidated by SDL_EVENT_WINDOW_RESIZED and SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED.
+    bool isLayoutValid = false;
+    SDL_FRect mapBoundaryBox = {0.0f, 0.0f, 0.0f, 0.0f};
+    float gridWidth = 0.0f;
+    float gridHeight = 0.0f;
+
+    // Status line rasterised once per score or status change, drawn as a texture in between.
+    SDL_Texture *statusTexture = nullptr;
+    bool isStatusValid = false;
+    Status status = PLAYING;
+    unsigned long score = 0UL;
+    float statusTextWidth = 0.0f;
+}; // struct RenderState
+
 struct AppState
 {
-    Uint64 previousTick; // for FixedUpdate() equivalent
-    SDL_Window *window = nullptr;
+    Uint64 renderedRevision = 0U; // BoardSnapshot::revision on screen
+    SDL_Window *window = nullptr;         // nullptr while capturing offscreen
+    SDL_Surface *captureSurface = nullptr; // software renderer target while capturing offscreen
     SDL_Renderer *renderer = nullptr;
+    RenderState renderState;
 };
 
 namespace Global
@@ -46,23 +98,88 @@ namespace Global
     static constexpr float MAXIMUM_TICK_PERIOD_MS_FLOAT = TICK_UNIT_TRAVELLED * 1000.0f / MAX_POSSIBLE_SPEED;
 
     static constexpr Uint64 DESIRED_TICK_PERIOD_MS = static_cast<Uint64>(MAXIMUM_TICK_PERIOD_MS_FLOAT - 1.0f);
+    static constexpr Sint32 IDLE_WAIT_TIMEOUT_MS = 1000; // upper bound of an idle SDL_AppIterate, events end it early
+
+    static constexpr size_t COMMAND_QUEUE_CAPACITY = 64U; // commands between two simulation wake-ups before the queue allocates
 
+    // Owned by the simulation thread once it runs, see run_simulation().
     entt::registry reg;
-    sigslot::signal<entt::registry &> gameplayUpdateSig;
+    using GameplayPipeline = SystemPipeline<SystemTranslate2D::iterate,
+                                            SnakeHamiltonianSolver::iterate, // MUST BE before SnakeGameplaySystem
+                                            SnakeGameplaySystem::iterate>;
     bool isGamePaused = false;
+    bool isAutopilotEnabled = false; // toggled with H; see SnakeHamiltonianSolver
+
+    // Input handed from the main thread to the simulation thread.
+    enum SimulationCommand : Uint8
+    {
+        UP = 0U,
+        LEFT,
+        DOWN,
+        RIGHT,
+        SHIFT_DOWN,
+        SHIFT_UP,
+        TOGGLE_PAUSE,
+        TOGGLE_AUTOPILOT,
+        RESTART,
+    }; // enum SimulationCommand
+    std::mutex simulationMutex; // guards commandQueue and isSimulationStopRequested
+    std::condition_variable simulationCondition;
+    std::vector<SimulationCommand> commandQueue;
+    bool isSimulationStopRequested = false;
+    std::thread simulationThread;
+
+    TripleBuffer<BoardSnapshot> boardSnapshots; // simulation thread writes, main thread renders
+
+    bool isRedrawRequested = false;  // by window events and F3, see SDL_AppIterate()
+    bool isHudVisible = false;       // toggled with F3
+    std::mutex frameStatsMutex;      // ticks are added by the simulation thread, frames by the main thread
+    FrameStats frameStats(0U);       // restarted in SDL_AppInit()
+    bool isMeasuringLatency = false; // --measure-latency
+    InputLatencyTracker inputLatencyTracker;
+
+    const char *captureDirectory = nullptr; // --capture, renders offscreen instead of into a window
+    std::vector<Uint8> levelMask;           // --level, empty for an open board; see SnakeGameplaySystem::parse_level()
+    int snakeCount = 1;                     // --snakes, 1 to MAP_HEIGHT, all steered by the same keys
+    std::vector<long> takenCells;           // start cells, scratch of init_gameplay_scene()
+    FrameEncoder::Format captureFormat = FrameEncoder::PPM; // --capture-format
+    FrameEncoder frameEncoder;
 } // namespace Global
 
-static SDL_FRect get_centered_boundary(SDL_Window *window, const int &hMargin, const int &vMargin)
+static bool is_movement_key(const SDL_Scancode &scancode)
+{
+    switch (scancode)
+    {
+    case SDL_SCANCODE_W:
+    case SDL_SCANCODE_UP:
+    case SDL_SCANCODE_A:
+    case SDL_SCANCODE_LEFT:
+    case SDL_SCANCODE_S:
+    case SDL_SCANCODE_DOWN:
+    case SDL_SCANCODE_D:
+    case SDL_SCANCODE_RIGHT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static SDL_FRect get_centered_boundary(SDL_Window *window, SDL_Renderer *renderer, const int &hMargin, const int &vMargin)
 {
-    SDL_assert(window != nullptr);
-    SDL_FRect ret;
+    SDL_assert(window != nullptr || renderer != nullptr);
+    SDL_FRect ret = {0.0f, 0.0f, 0.0f, 0.0f};
 
-    int windowWidth, windowHeight;
-    if (!SDL_GetWindowSize(window, &windowWidth, &windowHeight))
+    int windowWidth, windowHeight; // the surface size while capturing offscreen
+    if (window != nullptr && !SDL_GetWindowSize(window, &windowWidth, &windowHeight))
     {
         std::cerr << "SDL_GetWindowSize error: " << SDL_GetError() << std::endl;
         return ret;
     }
+    if (window == nullptr && !SDL_GetCurrentRenderOutputSize(renderer, &windowWidth, &windowHeight))
+    {
+        std::cerr << "SDL_GetCurrentRenderOutputSize error: " << SDL_GetError() << std::endl;
+        return ret;
+    }
 
     if (windowWidth < windowHeight)
     {
@@ -78,9 +195,8 @@ static SDL_FRect get_centered_boundary(SDL_Window *window, const int &hMargin, c
     return ret;
 }
 
-static bool render_map_border(SDL_Window *window, SDL_Renderer *renderer, const int &hMargin, const int &vMargin)
+static bool render_map_border(SDL_Renderer *renderer, const SDL_FRect &mapBoundaryBox)
 {
-    SDL_assert(window != nullptr);
     SDL_assert(renderer != nullptr);
     if (!SDL_SetRenderDrawColor(renderer, 0U, 0U, 0U, SDL_ALPHA_OPAQUE))
     {
@@ -98,46 +214,155 @@ static bool render_map_border(SDL_Window *window, SDL_Renderer *renderer, const
         return false;
     }
 
-    int windowWidth, windowHeight;
-    if (!SDL_GetWindowSize(window, &windowWidth, &windowHeight))
+    if (!SDL_RenderRect(renderer, &mapBoundaryBox))
     {
-        std::cerr << "SDL_GetWindowSize error: " << SDL_GetError() << std::endl;
+        std::cerr << "SDL_RenderRect error: " << SDL_GetError() << std::endl;
         return false;
     }
 
-    SDL_FRect mapBoundaryBox = get_centered_boundary(window, hMargin, vMargin);
+    return true;
+}
+
+static bool update_layout(SDL_Window *window, SDL_Renderer *renderer, RenderState &renderState, const int &hMargin, const int &vMargin)
+{
+    if (renderState.isLayoutValid)
+        return true;
+
+    const SDL_FRect mapBoundaryBox = get_centered_boundary(window, renderer, hMargin, vMargin);
     if (mapBoundaryBox.w <= 0.0f || mapBoundaryBox.h <= 0.0f)
         return false;
 
-    if (!SDL_RenderRect(renderer, &mapBoundaryBox))
+    renderState.mapBoundaryBox = mapBoundaryBox;
+    renderState.gridWidth = mapBoundaryBox.w / static_cast<float>(Global::MAP_WIDTH);
+    renderState.gridHeight = mapBoundaryBox.h / static_cast<float>(Global::MAP_HEIGHT);
+    renderState.isLayoutValid = true;
+    return true;
+}
+
+static bool update_status_texture(SDL_Renderer *renderer, RenderState &renderState, const RenderState::Status &status, const unsigned long &score)
+{
+    SDL_assert(renderer != nullptr);
+    if (renderState.isStatusValid && renderState.status == status && renderState.score == score)
+        return true;
+
+    const int charSize = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    if (renderState.statusTexture == nullptr)
     {
-        std::cerr << "SDL_RenderRect error: " << SDL_GetError() << std::endl;
+        renderState.statusTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+                                                      RenderState::STATUS_TEXT_MAX_LENGTH * charSize, charSize);
+        if (renderState.statusTexture == nullptr)
+        {
+            std::cerr << "SDL_CreateTexture error: " << SDL_GetError() << std::endl;
+            return false;
+        }
+        SDL_SetTextureBlendMode(renderState.statusTexture, SDL_BLENDMODE_BLEND);
+    }
+
+    const char *textContent;
+    Uint8 r = 255U, g = 255U, b = 255U;
+    switch (status)
+    {
+    case RenderState::PAUSED:
+        textContent = "Game paused. Press ESC to resume. Score: %lu";
+        break;
+    case RenderState::SUCCESS:
+        textContent = "Congratulations! You won! Press R to restart. Score: %lu";
+        r = 0U;
+        b = 0U;
+        break;
+    case RenderState::FAILURE:
+        textContent = "Game over! Press R to restart. Score: %lu";
+        g = 0U;
+        b = 0U;
+        break;
+    default:
+        textContent = "Score: %lu";
+        break;
+    }
+    char text[RenderState::STATUS_TEXT_MAX_LENGTH + 1];
+    const int textLength = SDL_min(std::snprintf(text, sizeof(text), textContent, score), RenderState::STATUS_TEXT_MAX_LENGTH);
+
+    bool ret = SDL_SetRenderTarget(renderer, renderState.statusTexture);
+    ret = ret && SDL_SetRenderDrawColor(renderer, 0U, 0U, 0U, SDL_ALPHA_TRANSPARENT);
+    ret = ret && SDL_RenderClear(renderer);
+    ret = ret && SDL_SetRenderDrawColor(renderer, r, g, b, SDL_ALPHA_OPAQUE);
+    ret = ret && SDL_RenderDebugText(renderer, 0.0f, 0.0f, text);
+    if (!SDL_SetRenderTarget(renderer, nullptr) || !ret)
+    {
+        std::cerr << "status text rendering error: " << SDL_GetError() << std::endl;
         return false;
     }
 
+    renderState.isStatusValid = true;
+    renderState.status = status;
+    renderState.score = score;
+    renderState.statusTextWidth = static_cast<float>(textLength * charSize);
     return true;
 }
 
-static bool render_gameplay_visuals(entt::registry &reg, SDL_Window *window, SDL_Renderer *renderer, const int &hMargin, const int &vMargin)
+static bool render_performance_hud(const BoardSnapshot &snapshot, SDL_Renderer *renderer)
 {
-    SDL_assert(window != nullptr);
     SDL_assert(renderer != nullptr);
-    if (!render_map_border(window, renderer, hMargin, vMargin))
+    if (!SDL_SetRenderDrawColor(renderer, 255U, 255U, 0U, SDL_ALPHA_OPAQUE))
+    {
+        std::cerr << "SDL_SetRenderDrawColor error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    FrameStats::Snapshot stats;
+    {
+        std::lock_guard<std::mutex> lock(Global::frameStatsMutex);
+        stats = Global::frameStats.get_snapshot();
+    }
+    const float x = 4.0f;
+    const float lineHeight = static_cast<float>(SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE) + 2.0f;
+    float y = 4.0f;
+    bool ret = true;
+    ret &= SDL_RenderDebugTextFormat(renderer, x, y, "ticks/s %.1f  fps %.1f", stats.ticksPerSecond, stats.framesPerSecond);
+    y += lineHeight;
+    ret &= SDL_RenderDebugTextFormat(renderer, x, y, "tick p99 %.3f ms  max %.3f ms", stats.tickP99Ns / 1000000.0, stats.tickMaxNs / 1000000.0);
+    y += lineHeight;
+#ifdef SNAKE_ENABLE_PROFILER
+    ret &= SDL_RenderDebugTextFormat(renderer, x, y, "catch-up ticks/frame max %u  alloc B/tick %llu",
+                                     static_cast<unsigned>(stats.catchUpTicksMax), static_cast<unsigned long long>(stats.allocatedBytesPerTick));
+#else
+    ret &= SDL_RenderDebugTextFormat(renderer, x, y, "catch-up ticks/frame max %u", static_cast<unsigned>(stats.catchUpTicksMax));
+#endif // SNAKE_ENABLE_PROFILER
+    y += lineHeight;
+    const BoardSnapshot::EntityCounts &counts = snapshot.entityCounts;
+    ret &= SDL_RenderDebugTextFormat(renderer, x, y, "pos %u vel %u head %u part %u apple %u",
+                                     static_cast<unsigned>(counts.position), static_cast<unsigned>(counts.velocity), static_cast<unsigned>(counts.head),
+                                     static_cast<unsigned>(counts.part), static_cast<unsigned>(counts.apple));
+    if (!ret)
+        std::cerr << "SDL_RenderDebugTextFormat error: " << SDL_GetError() << std::endl;
+    return ret;
+}
+
+static bool render_gameplay_visuals(const BoardSnapshot &snapshot, SDL_Window *window, SDL_Renderer *renderer, RenderState &renderState, const int &hMargin, const int &vMargin)
+{
+    SNAKE_PROFILE_SCOPE(TickProfiler::RENDER);
+    SNAKE_TRACE_SCOPE("render_gameplay_visuals");
+    SDL_assert(renderer != nullptr);
+    if (!update_layout(window, renderer, renderState, hMargin, vMargin))
+        return false;
+    const SDL_FRect &mapBoundaryBox = renderState.mapBoundaryBox;
+    if (!render_map_border(renderer, mapBoundaryBox))
     {
         return false;
     }
 
-    auto gameplayVecVec = SnakeGameplaySystem::get_map(reg);
-    SDL_FRect mapBoundaryBox = get_centered_boundary(window, hMargin, vMargin);
-    const float gridHeight = static_cast<float>(mapBoundaryBox.h) / static_cast<float>(gameplayVecVec.size());
-    for (int i = 0; i < gameplayVecVec.size(); i++)
+    const float gridWidth = renderState.gridWidth;
+    const float gridHeight = renderState.gridHeight;
+    for (int i = 0; i < snapshot.height; i++)
     {
-        const float gridWidth = static_cast<float>(mapBoundaryBox.w) / static_cast<float>(gameplayVecVec[i].size());
-        for (int j = 0; j < gameplayVecVec[i].size(); j++)
+        for (int j = 0; j < snapshot.width; j++)
         {
-            const Uint8 r = (gameplayVecVec[i][j] & SnakeGameplaySystem::MapSlotState::APPLE) ? 255U : 0U;
-            const Uint8 g = (gameplayVecVec[i][j] & SnakeGameplaySystem::MapSlotState::SNAKE_BODY) ? 255U : 0U;
-            const Uint8 b = (gameplayVecVec[i][j] & SnakeGameplaySystem::MapSlotState::SNAKE_HEAD) ? 255U : 0U;
+            const Uint8 slot = snapshot.board[static_cast<size_t>(i) * snapshot.width + j];
+            Uint8 r = (slot & SnakeGameplaySystem::MapSlotState::APPLE) ? 255U : 0U;
+            Uint8 g = (slot & SnakeGameplaySystem::MapSlotState::SNAKE_BODY) ? 255U : 0U;
+            Uint8 b = (slot & SnakeGameplaySystem::MapSlotState::SNAKE_HEAD) ? 255U : 0U;
+            if (slot == SnakeGameplaySystem::MapSlotState::OBSTACLE) // grey, a head crashed into it keeps its colour
+                r = g = b = 128U;
             const float xCoord = static_cast<float>(j) * gridWidth + mapBoundaryBox.x;
             const float yCoord = static_cast<float>(i) * gridHeight + mapBoundaryBox.y;
             SDL_FRect grid = {xCoord, yCoord, gridWidth, gridHeight};
@@ -157,51 +382,42 @@ static bool render_gameplay_visuals(entt::registry &reg, SDL_Window *window, SDL
         }
     }
 
-    if (!SDL_SetRenderDrawColor(renderer, 255U, 255U, 255U, SDL_ALPHA_OPAQUE))
-    {
-        std::cerr << "SDL_SetRenderDrawColor error: " << SDL_GetError() << std::endl;
+    RenderState::Status status = RenderState::PLAYING;
+    if (snapshot.isPaused)
+        status = RenderState::PAUSED;
+    else if (snapshot.status == BoardSnapshot::SUCCESS)
+        status = RenderState::SUCCESS;
+    else if (snapshot.status == BoardSnapshot::FAILURE)
+        status = RenderState::FAILURE;
+    if (!update_status_texture(renderer, renderState, status, snapshot.score))
         return false;
-    }
 
-    const float textY = mapBoundaryBox.y + mapBoundaryBox.h + 10.0f;
-    std::string textContent;
-    if (Global::isGamePaused)
+    const float charSize = static_cast<float>(SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE);
+    const SDL_FRect textSource = {0.0f, 0.0f, renderState.statusTextWidth, charSize};
+    const SDL_FRect textDestination = {mapBoundaryBox.x, mapBoundaryBox.y + mapBoundaryBox.h + 10.0f, renderState.statusTextWidth, charSize};
+    if (!SDL_RenderTexture(renderer, renderState.statusTexture, &textSource, &textDestination))
     {
-        if (!SDL_SetRenderDrawColor(renderer, 255U, 255U, 255U, SDL_ALPHA_OPAQUE))
-        {
-            std::cerr << "SDL_SetRenderDrawColor error: " << SDL_GetError() << std::endl;
-            return false;
-        }
-        textContent = "Game paused. Press ESC to resume. Score: %lu";
-    }
-    else if (SnakeGameplaySystem::is_game_success(reg))
-    {
-        if (!SDL_SetRenderDrawColor(renderer, 0U, 255U, 0U, SDL_ALPHA_OPAQUE))
-        {
-            std::cerr << "SDL_SetRenderDrawColor error: " << SDL_GetError() << std::endl;
-            return false;
-        }
-        textContent = "Congratulations! You won! Press R to restart. Score: %lu";
+        std::cerr << "SDL_RenderTexture error: " << SDL_GetError() << std::endl;
+        return false;
     }
-    else if (SnakeGameplaySystem::is_game_failure(reg))
+
+    if (Global::isHudVisible && !render_performance_hud(snapshot, renderer))
+        return false;
+
     {
-        if (!SDL_SetRenderDrawColor(renderer, 255U, 0U, 0U, SDL_ALPHA_OPAQUE))
-        {
-            std::cerr << "SDL_SetRenderDrawColor error: " << SDL_GetError() << std::endl;
-            return false;
-        }
-        textContent = "Game over! Press R to restart. Score: %lu";
+        std::lock_guard<std::mutex> lock(Global::frameStatsMutex);
+        Global::frameStats.add_frame();
     }
-    else
-        textContent = "Score: %lu";
-
-    if (!SDL_RenderDebugTextFormat(renderer, mapBoundaryBox.x, textY, textContent.c_str(), SnakeGameplaySystem::get_score(reg)))
+    if (Global::isMeasuringLatency)
+        Global::inputLatencyTracker.on_frame(snapshot.headCell, SDL_GetTicksNS());
+    bool isPresented;
     {
-        std::cerr << "SDL_RenderDebugTextFormat error: " << SDL_GetError() << std::endl;
-        return false;
+        SNAKE_TRACE_SCOPE("SDL_RenderPresent");
+        isPresented = SDL_RenderPresent(renderer);
     }
-
-    if (!SDL_RenderPresent(renderer))
+    if (Global::isMeasuringLatency)
+        Global::inputLatencyTracker.on_present(SDL_GetTicksNS());
+    if (!isPresented)
     {
         std::cerr << "SDL_RenderPresent error: " << SDL_GetError() << std::endl;
         return false;
@@ -210,32 +426,275 @@ static bool render_gameplay_visuals(entt::registry &reg, SDL_Window *window, SDL
     return true;
 }
 
+static void render_frame(AppState *appstate, const BoardSnapshot &snapshot)
+{
+    SDL_assert(appstate != nullptr);
+    const bool isRendered = render_gameplay_visuals(snapshot, appstate->window, appstate->renderer, appstate->renderState, Global::MAP_MARGIN_PX, Global::MAP_MARGIN_PX);
+    if (isRendered && appstate->captureSurface != nullptr) // presented, so the surface holds the frame
+        Global::frameEncoder.push(appstate->captureSurface->pixels, appstate->captureSurface->pitch);
+}
+
 static void init_gameplay_scene(entt::registry &reg)
 {
-    reg.clear();
+    reg.clear(); // keeps the capacity reserved below, so a restart SHOULD NOT allocate, see allocation_test
+    SnakeGameplaySystem::reserve(reg, {Global::MAP_WIDTH, Global::MAP_HEIGHT}, static_cast<size_t>(Global::snakeCount));
     auto gameStateEntity = reg.create();
     reg.emplace<DeltaTime>(gameStateEntity, Global::DESIRED_TICK_PERIOD_MS);
     reg.emplace<KeyControl>(gameStateEntity, 'd', false);
     reg.emplace<SnakeBoundary2D>(gameStateEntity, Global::MAP_WIDTH, Global::MAP_HEIGHT);
+    if (Global::isAutopilotEnabled)
+        reg.emplace<SnakeAutopilot>(gameStateEntity, true);
+
+    // On a level, a start cell under an obstacle moves to the nearest open one.
+    Global::takenCells.clear();
+    auto place = [&reg](const entt::entity &entity, const Position &pos)
+    {
+        const SnakeBoundary2D boundary{Global::MAP_WIDTH, Global::MAP_HEIGHT};
+        long x, y;
+        SnakeGameplaySystem::Util::get_index_from_pos(pos, &x, &y, boundary.y);
+        const long cell = SnakeGameplaySystem::find_open_cell(reg, boundary, y * boundary.x + x, Global::takenCells.data(), Global::takenCells.size());
+        SDL_assert(cell >= 0); // parse_level() leaves room for the head and an apple
+        if (cell == y * boundary.x + x)
+            reg.emplace<Position>(entity, pos);
+        else
+            reg.emplace<Position>(entity, SnakeGameplaySystem::Util::get_pos_from_index(cell % boundary.x, cell / boundary.x, boundary.y));
+        Global::takenCells.push_back(cell);
+    };
 
-    auto appleEntity = reg.create();
     const float centerX = static_cast<float>(Global::MAP_WIDTH) / 2.0f;
     const float centerY = static_cast<float>(Global::MAP_HEIGHT) / 2.0f;
-    reg.emplace<Position>(appleEntity, centerX, centerY);
-    reg.emplace<SnakeApple>(appleEntity);
+    for (int k = 0; k < Global::snakeCount; k++)
+    { // one snake below the centre apple, or several spread over the rows, each behind its own apple
+        const float rowY = static_cast<float>(Global::MAP_HEIGHT * (k + 1) / (Global::snakeCount + 1)) + 0.5f;
+        auto appleEntity = reg.create();
+        place(appleEntity, Global::snakeCount == 1 ? Position{centerX, centerY} : Position{centerX, rowY});
+        reg.emplace<SnakeApple>(appleEntity);
+
+        auto snakeHeadEntity = reg.create();
+        if (Global::snakeCount > 1)
+            place(snakeHeadEntity, Position{2.5f, rowY});
+        else if (centerY >= 1.5f)
+            place(snakeHeadEntity, Position{2.5f, centerY - 1.0f});
+        else
+            place(snakeHeadEntity, Position{2.5f, 0.5f});
+        reg.emplace<Velocity>(snakeHeadEntity, 0.0f, 0.0f);
+        reg.emplace<SnakePartHead>(snakeHeadEntity, Global::SPEED, Global::SPEED_UP_FACTOR);
+    }
+    SnakeGameplaySystem::init(reg); // also on restart: the apple index and previous map follow the new scene
+}
 
-    auto snakeHeadEntity = reg.create();
-    if (centerY >= 1.5f)
-        reg.emplace<Position>(snakeHeadEntity, 2.5f, centerY - 1.0f);
-    else
-        reg.emplace<Position>(snakeHeadEntity, 2.5f, 0.5f);
-    reg.emplace<Velocity>(snakeHeadEntity, 0.0f, 0.0f);
-    reg.emplace<SnakePartHead>(snakeHeadEntity, Global::SPEED, Global::SPEED_UP_FACTOR);
+static bool is_simulation_idle()
+{
+    return Global::isGamePaused || SnakeGameplaySystem::is_game_success(Global::reg) || SnakeGameplaySystem::is_game_failure(Global::reg);
+}
+
+// Simulation thread, or the main thread before the simulation thread starts.
+static void publish_board_snapshot(const Uint64 &tickCount)
+{
+    static BoardSnapshot lastPublished; // for the revision, the buffers rotate
+    BoardSnapshot &snapshot = Global::boardSnapshots.get_write_buffer();
+    snapshot.capture(Global::reg);
+    snapshot.isPaused = Global::isGamePaused;
+    snapshot.tickCount = tickCount;
+    snapshot.capturedNs = SDL_GetTicksNS();
+    snapshot.revision = snapshot.is_same_view(lastPublished) ? lastPublished.revision : lastPublished.revision + 1U;
+
+    // An idle main thread sleeps in SDL_WaitEventTimeout(); wake it up for changes it would otherwise miss.
+    const bool isWakeUpNeeded = snapshot.revision != lastPublished.revision && (snapshot.is_idle() || lastPublished.is_idle());
+    lastPublished = snapshot;
+    Global::boardSnapshots.publish();
+    if (isWakeUpNeeded)
+    {
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        SDL_PushEvent(&event);
+    }
+}
+
+static void apply_simulation_command(const Global::SimulationCommand &command)
+{
+    switch (command)
+    {
+    case Global::UP:
+        SnakeGameplaySystem::Control::up_key_down(Global::reg);
+        break;
+    case Global::LEFT:
+        SnakeGameplaySystem::Control::left_key_down(Global::reg);
+        break;
+    case Global::DOWN:
+        SnakeGameplaySystem::Control::down_key_down(Global::reg);
+        break;
+    case Global::RIGHT:
+        SnakeGameplaySystem::Control::right_key_down(Global::reg);
+        break;
+    case Global::SHIFT_DOWN:
+        SnakeGameplaySystem::Control::shift_key_down(Global::reg);
+        break;
+    case Global::SHIFT_UP:
+        SnakeGameplaySystem::Control::shift_key_up(Global::reg);
+        break;
+    case Global::TOGGLE_PAUSE:
+        if (!SnakeGameplaySystem::is_game_success(Global::reg) && !SnakeGameplaySystem::is_game_failure(Global::reg))
+            Global::isGamePaused = !Global::isGamePaused;
+        break;
+    case Global::TOGGLE_AUTOPILOT:
+    {
+        Global::isAutopilotEnabled = !Global::isAutopilotEnabled;
+        auto gameStateEntity = Global::reg.view<SnakeBoundary2D>().front();
+        if (Global::isAutopilotEnabled)
+            Global::reg.emplace_or_replace<SnakeAutopilot>(gameStateEntity, true);
+        else
+            Global::reg.remove<SnakeAutopilot>(gameStateEntity);
+        break;
+    }
+    case Global::RESTART:
+        if (SnakeGameplaySystem::is_game_failure(Global::reg) || SnakeGameplaySystem::is_game_success(Global::reg))
+            init_gameplay_scene(Global::reg);
+        break;
+    default:
+        break;
+    }
+}
+
+// Main thread.
+static void push_simulation_command(const Global::SimulationCommand &command)
+{
+    {
+        std::lock_guard<std::mutex> lock(Global::simulationMutex);
+        Global::commandQueue.push_back(command);
+    }
+    Global::simulationCondition.notify_one();
+}
+
+// Runs the fixed ticks on its own thread so that a slow SDL_RenderPresent() never delays
+// them, and publishes a BoardSnapshot after every batch of ticks or commands. Sleeps until
+// the next tick is due, or while idle until a command arrives.
+static void run_simulation()
+{
+    std::vector<Global::SimulationCommand> commands;
+    commands.reserve(Global::COMMAND_QUEUE_CAPACITY);
+    Uint64 tickCount = 0U;
+    Uint64 previousTick = SDL_GetTicks(); // for FixedUpdate() equivalent
+
+    std::unique_lock<std::mutex> lock(Global::simulationMutex);
+    while (!Global::isSimulationStopRequested)
+    {
+        auto isWakeUpRequested = []()
+        { return Global::isSimulationStopRequested || !Global::commandQueue.empty(); };
+        const bool isIdle = is_simulation_idle();
+        if (isIdle)
+            Global::simulationCondition.wait(lock, isWakeUpRequested);
+        else
+        {
+            const Uint64 elapsed = SDL_GetTicks() - previousTick;
+            if (elapsed < Global::DESIRED_TICK_PERIOD_MS)
+                Global::simulationCondition.wait_for(lock, std::chrono::milliseconds(Global::DESIRED_TICK_PERIOD_MS - elapsed), isWakeUpRequested);
+        }
+        if (Global::isSimulationStopRequested)
+            break;
+        commands.swap(Global::commandQueue);
+        lock.unlock();
+
+        const bool isCommanded = !commands.empty();
+        for (const auto &command : commands)
+            apply_simulation_command(command);
+        commands.clear();
+        if (isIdle)
+            previousTick = SDL_GetTicks(); // resume without a burst of catch-up ticks
+
+        const Uint64 now = SDL_GetTicks();
+        Uint32 ticksRun = 0U;
+        while (now - previousTick >= Global::DESIRED_TICK_PERIOD_MS) // for FixedUpdate() equivalent
+        {
+            SNAKE_TRACE_SCOPE("fixed_tick");
+            // The reason why is because of how the body follows the head.
+            // It is dependent on body entites 2 blocks away in 4 directions from head.
+            // If system lags, the head may get detached if deltaTime is not fixed.
+            if (!is_simulation_idle())
+            {
+                SNAKE_PROFILE_SCOPE(TickProfiler::TICK);
+                const Uint64 tickStartNs = SDL_GetTicksNS();
+                const Uint64 allocatedBytes = AllocationCounter::get_thread_allocated_bytes(); // not the render or worker threads
+                Global::GameplayPipeline::iterate(Global::reg); // effectively pauses game if failed or succeeded
+                const Uint64 tickEndNs = SDL_GetTicksNS();
+                std::lock_guard<std::mutex> statsLock(Global::frameStatsMutex);
+                Global::frameStats.add_tick(tickEndNs - tickStartNs, AllocationCounter::get_thread_allocated_bytes() - allocatedBytes);
+            }
+            previousTick += Global::DESIRED_TICK_PERIOD_MS;
+            ticksRun++;
+        }
+        tickCount += ticksRun;
+        if (ticksRun > 0U)
+        {
+            std::lock_guard<std::mutex> statsLock(Global::frameStatsMutex);
+            Global::frameStats.add_iterate(ticksRun);
+        }
+        if (ticksRun > 0U || isCommanded)
+            publish_board_snapshot(tickCount);
+
+        lock.lock();
+    }
+}
+
+static void stop_simulation()
+{
+    if (!Global::simulationThread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(Global::simulationMutex);
+        Global::isSimulationStopRequested = true;
+    }
+    Global::simulationCondition.notify_one();
+    Global::simulationThread.join();
 }
 
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv)
 {
-    if (!SDL_Init(SDL_INIT_VIDEO))
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg(argv[i]);
+        if (arg == "--trace" && i + 1 < argc)
+        {
+            if (!TraceRecorder::start(argv[++i]))
+                std::cerr << "TraceRecorder::start error: cannot write " << argv[i] << std::endl;
+        }
+        else if (arg == "--measure-latency")
+            Global::isMeasuringLatency = true; // report on exit or with P
+        else if (arg == "--capture" && i + 1 < argc)
+            Global::captureDirectory = argv[++i];
+        else if (arg == "--capture-format" && i + 1 < argc)
+        {
+            if (!FrameEncoder::parse_format(argv[++i], &Global::captureFormat))
+                std::cerr << "unknown capture format " << argv[i] << ", expected ppm, raw or rle" << std::endl;
+        }
+        else if (arg == "--level" && i + 1 < argc)
+        {
+            size_t length = 0U;
+            char *text = static_cast<char *>(SDL_LoadFile(argv[++i], &length));
+            if (text == nullptr)
+                std::cerr << "SDL_LoadFile error: " << SDL_GetError() << std::endl;
+            else if (!SnakeGameplaySystem::parse_level(text, length, {Global::MAP_WIDTH, Global::MAP_HEIGHT}, Global::levelMask))
+            {
+                std::cerr << "level error: " << argv[i] << " MUST fit in " << Global::MAP_WIDTH << " x " << Global::MAP_HEIGHT
+                          << " cells and leave two of them open" << std::endl;
+                Global::levelMask.clear();
+            }
+            SDL_free(text);
+        }
+        else if (arg == "--snakes" && i + 1 < argc)
+        {
+            Global::snakeCount = SDL_atoi(argv[++i]);
+            if (Global::snakeCount < 1 || Global::snakeCount > Global::MAP_HEIGHT)
+            {
+                std::cerr << "--snakes MUST BE from 1 to " << Global::MAP_HEIGHT << ", got " << argv[i] << std::endl;
+                Global::snakeCount = 1;
+            }
+        }
+    }
+    Global::takenCells.reserve(2U * static_cast<size_t>(Global::snakeCount)); // so a restart does not allocate
+
+    if (!SDL_Init(Global::captureDirectory != nullptr ? SDL_INIT_EVENTS : SDL_INIT_VIDEO)) // no display needed to capture
     {
         std::cerr << "SDL_Init error: " << SDL_GetError() << std::endl;
         return SDL_APP_FAILURE;
@@ -249,56 +708,107 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char **argv)
     *appstate = new AppState();
     AppState *appstateCasted = static_cast<AppState *>(*appstate);
 
-    appstateCasted->window = SDL_CreateWindow("Snake Game CPP", Global::WINDOW_WIDTH, Global::WINDOW_HEIGHT, SDL_WINDOW_INPUT_FOCUS);
-    if (appstateCasted->window == nullptr)
+    if (Global::captureDirectory != nullptr)
     {
-        std::cerr << "SDL_CreateWindow error: " << SDL_GetError() << std::endl;
-        SDL_Quit();
-        return SDL_APP_FAILURE;
-    }
+        // Offscreen: the software renderer draws into a surface that FrameEncoder copies out.
+        appstateCasted->captureSurface = SDL_CreateSurface(Global::WINDOW_WIDTH, Global::WINDOW_HEIGHT, SDL_PIXELFORMAT_XRGB8888);
+        if (appstateCasted->captureSurface == nullptr)
+        {
+            std::cerr << "SDL_CreateSurface error: " << SDL_GetError() << std::endl;
+            SDL_Quit();
+            return SDL_APP_FAILURE;
+        }
 
-    appstateCasted->renderer = SDL_CreateRenderer(appstateCasted->window, NULL);
-    if (appstateCasted->renderer == nullptr)
+        appstateCasted->renderer = SDL_CreateSoftwareRenderer(appstateCasted->captureSurface);
+        if (appstateCasted->renderer == nullptr)
+        {
+            std::cerr << "SDL_CreateSoftwareRenderer error: " << SDL_GetError() << std::endl;
+            SDL_DestroySurface(appstateCasted->captureSurface);
+            SDL_Quit();
+            return SDL_APP_FAILURE;
+        }
+
+        if (!SDL_CreateDirectory(Global::captureDirectory) ||
+            !Global::frameEncoder.start(Global::captureDirectory, Global::captureFormat, Global::WINDOW_WIDTH, Global::WINDOW_HEIGHT))
+        {
+            std::cerr << "capture error: cannot write to " << Global::captureDirectory << std::endl;
+            SDL_DestroyRenderer(appstateCasted->renderer);
+            SDL_DestroySurface(appstateCasted->captureSurface);
+            SDL_Quit();
+            return SDL_APP_FAILURE;
+        }
+        Global::isAutopilotEnabled = true; // nobody at the keyboard
+    }
+    else
     {
-        std::cerr << "SDL_CreateRenderer error: " << SDL_GetError() << std::endl;
-        SDL_DestroyWindow(appstateCasted->window);
-        SDL_Quit();
-        return SDL_APP_FAILURE;
+        appstateCasted->window = SDL_CreateWindow("Snake Game CPP", Global::WINDOW_WIDTH, Global::WINDOW_HEIGHT, SDL_WINDOW_INPUT_FOCUS);
+        if (appstateCasted->window == nullptr)
+        {
+            std::cerr << "SDL_CreateWindow error: " << SDL_GetError() << std::endl;
+            SDL_Quit();
+            return SDL_APP_FAILURE;
+        }
+
+        appstateCasted->renderer = SDL_CreateRenderer(appstateCasted->window, NULL);
+        if (appstateCasted->renderer == nullptr)
+        {
+            std::cerr << "SDL_CreateRenderer error: " << SDL_GetError() << std::endl;
+            SDL_DestroyWindow(appstateCasted->window);
+            SDL_Quit();
+            return SDL_APP_FAILURE;
+        }
     }
 
+    // Once per run: reg.clear() on restart keeps the level, see SnakeGameplaySystem::ObstacleLayer.
+    SnakeGameplaySystem::load_obstacles(Global::reg, {Global::MAP_WIDTH, Global::MAP_HEIGHT},
+                                        Global::levelMask.empty() ? nullptr : Global::levelMask.data());
     init_gameplay_scene(Global::reg);
-    SystemTranslate2D::init(Global::gameplayUpdateSig);
-    SnakeGameplaySystem::init(Global::gameplayUpdateSig, Global::reg);
+    Global::frameStats = FrameStats(SDL_GetTicksNS());
 
-    render_gameplay_visuals(Global::reg, appstateCasted->window, appstateCasted->renderer, Global::MAP_MARGIN_PX, Global::MAP_MARGIN_PX);
+    publish_board_snapshot(0U);
+    Global::boardSnapshots.update();
+    const BoardSnapshot &snapshot = Global::boardSnapshots.get_read_buffer();
+    appstateCasted->renderedRevision = snapshot.revision;
+    render_frame(appstateCasted, snapshot);
 
-    appstateCasted->previousTick = SDL_GetTicks(); // for FixedUpdate() equivalent
+    Global::commandQueue.reserve(Global::COMMAND_QUEUE_CAPACITY);
+    Global::simulationThread = std::thread(run_simulation); // owns Global::reg from here on
     return SDL_APP_CONTINUE;
 }
 
 SDL_AppResult SDL_AppIterate(void *appstate)
 {
     AppState *appstateCasted = static_cast<AppState *>(appstate);
+    SNAKE_TRACE_SCOPE("SDL_AppIterate");
 
-    const Uint64 now = SDL_GetTicks();
-    while (now - appstateCasted->previousTick >= Global::DESIRED_TICK_PERIOD_MS) // for FixedUpdate() equivalent
+    // Snapshots published in between are skipped; a turn stays visible in the head velocity of later ones.
+    if (Global::boardSnapshots.update() && Global::isMeasuringLatency)
     {
-        // The reason why is because of how the body follows the head.
-        // It is dependent on body entites 2 blocks away in 4 directions from head.
-        // If system lags, the head may get detached if deltaTime is not fixed.
-        if (!Global::isGamePaused && !SnakeGameplaySystem::is_game_success(Global::reg) && !SnakeGameplaySystem::is_game_failure(Global::reg))
-            Global::gameplayUpdateSig(Global::reg); // effectively pauses game if failed or succeeded
-        appstateCasted->previousTick += Global::DESIRED_TICK_PERIOD_MS;
+        const BoardSnapshot &snapshot = Global::boardSnapshots.get_read_buffer();
+        Global::inputLatencyTracker.on_tick(snapshot.headVelocity.x, snapshot.headVelocity.y, snapshot.headCell, snapshot.capturedNs);
+    }
+    const BoardSnapshot &snapshot = Global::boardSnapshots.get_read_buffer();
 
-        static auto previousMap = SnakeGameplaySystem::get_map(Global::reg);
-        auto currentMap = SnakeGameplaySystem::get_map(Global::reg);
-        if (currentMap != previousMap || Global::isGamePaused)
-        {
-            previousMap = currentMap;
-            render_gameplay_visuals(Global::reg, appstateCasted->window, appstateCasted->renderer, Global::MAP_MARGIN_PX, Global::MAP_MARGIN_PX);
-        }
+    bool isHudRefreshed;
+    {
+        std::lock_guard<std::mutex> lock(Global::frameStatsMutex);
+        isHudRefreshed = Global::frameStats.update(SDL_GetTicksNS()) && Global::isHudVisible; // HUD refreshes at least once per window
+    }
+    if (snapshot.revision != appstateCasted->renderedRevision || Global::isRedrawRequested || isHudRefreshed)
+    {
+        Global::isRedrawRequested = false;
+        appstateCasted->renderedRevision = snapshot.revision;
+        render_frame(appstateCasted, snapshot);
     }
-    SDL_Delay(Global::DESIRED_TICK_PERIOD_MS / 2U); // MUST BE DIVIDED BY >= 2U; saves some CPU
+    if (Global::captureDirectory != nullptr && snapshot.status != BoardSnapshot::PLAYING)
+        return SDL_APP_SUCCESS; // the recorded game is over
+
+    // Idle while paused or finished: sleep until the next input or window event, or until the
+    // simulation publishes a change (see publish_board_snapshot()), instead of spinning.
+    if (snapshot.is_idle())
+        SDL_WaitEventTimeout(nullptr, Global::IDLE_WAIT_TIMEOUT_MS); // leaves the event queued for SDL_AppEvent()
+    else
+        SDL_Delay(Global::DESIRED_TICK_PERIOD_MS / 2U); // MUST BE DIVIDED BY >= 2U; saves some CPU
 
     return SDL_APP_CONTINUE;
 }
@@ -309,42 +819,81 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event)
     {
     case SDL_EVENT_QUIT:
         return SDL_APP_SUCCESS;
+    case SDL_EVENT_WINDOW_RESIZED:
+    case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+        static_cast<AppState *>(appstate)->renderState.isLayoutValid = false;
+        Global::isRedrawRequested = true;
+        break;
+    case SDL_EVENT_WINDOW_EXPOSED:
+        Global::isRedrawRequested = true;
+        break;
+    case SDL_EVENT_RENDER_TARGETS_RESET: // the status texture lost its content
+        static_cast<AppState *>(appstate)->renderState.isStatusValid = false;
+        Global::isRedrawRequested = true;
+        break;
+    case SDL_EVENT_RENDER_DEVICE_RESET: // textures MUST BE recreated
+    {
+        RenderState &renderState = static_cast<AppState *>(appstate)->renderState;
+        if (renderState.statusTexture != nullptr)
+            SDL_DestroyTexture(renderState.statusTexture);
+        renderState.statusTexture = nullptr;
+        renderState.isStatusValid = false;
+        Global::isRedrawRequested = true;
+        break;
+    }
     case SDL_EVENT_KEY_DOWN:
     {
         const SDL_KeyboardEvent &eventKey = event->key;
         const SDL_Scancode &scancode = eventKey.scancode;
+        const BoardSnapshot &snapshot = Global::boardSnapshots.get_read_buffer();
+        const bool isTrackingLatency = Global::isMeasuringLatency && is_movement_key(scancode) && !eventKey.repeat;
+        if (isTrackingLatency)
+            Global::inputLatencyTracker.on_key_down(eventKey.timestamp, snapshot.headVelocity.x, snapshot.headVelocity.y);
         switch (scancode)
         {
         case SDL_SCANCODE_ESCAPE:
-            if (SnakeGameplaySystem::is_game_success(Global::reg) || SnakeGameplaySystem::is_game_failure(Global::reg))
+            if (snapshot.status != BoardSnapshot::PLAYING)
                 return SDL_APP_SUCCESS;
-            Global::isGamePaused = !Global::isGamePaused;
+            push_simulation_command(Global::TOGGLE_PAUSE);
             break;
         case SDL_SCANCODE_W:
         case SDL_SCANCODE_UP:
-            SnakeGameplaySystem::Control::up_key_down(Global::reg);
+            push_simulation_command(Global::UP);
             break;
         case SDL_SCANCODE_A:
         case SDL_SCANCODE_LEFT:
-            SnakeGameplaySystem::Control::left_key_down(Global::reg);
+            push_simulation_command(Global::LEFT);
             break;
         case SDL_SCANCODE_S:
         case SDL_SCANCODE_DOWN:
-            SnakeGameplaySystem::Control::down_key_down(Global::reg);
+            push_simulation_command(Global::DOWN);
             break;
         case SDL_SCANCODE_D:
         case SDL_SCANCODE_RIGHT:
-            SnakeGameplaySystem::Control::right_key_down(Global::reg);
+            push_simulation_command(Global::RIGHT);
             break;
         case SDL_SCANCODE_SPACE:
-            SnakeGameplaySystem::Control::shift_key_down(Global::reg);
+            push_simulation_command(Global::SHIFT_DOWN);
+            break;
+        case SDL_SCANCODE_H:
+            push_simulation_command(Global::TOGGLE_AUTOPILOT);
+            break;
+        case SDL_SCANCODE_F3:
+            Global::isHudVisible = !Global::isHudVisible;
+            Global::isRedrawRequested = true;
+            break;
+        case SDL_SCANCODE_P:
+            TickProfiler::dump(); // empty unless built with SNAKE_ENABLE_PROFILER
+            if (Global::isMeasuringLatency)
+                Global::inputLatencyTracker.dump();
             break;
         case SDL_SCANCODE_R:
-            if (SnakeGameplaySystem::is_game_failure(Global::reg) || SnakeGameplaySystem::is_game_success(Global::reg))
-                init_gameplay_scene(Global::reg);
+            push_simulation_command(Global::RESTART);
         default:
             break;
         }
+        if (isTrackingLatency)
+            Global::inputLatencyTracker.on_key_control(SDL_GetTicksNS());
         break;
     }
     case SDL_EVENT_KEY_UP:
@@ -352,7 +901,7 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event)
         const SDL_KeyboardEvent &eventKey = event->key;
         const SDL_Scancode &scancode = eventKey.scancode;
         if (scancode == SDL_SCANCODE_SPACE)
-            SnakeGameplaySystem::Control::shift_key_up(Global::reg);
+            push_simulation_command(Global::SHIFT_UP);
     }
     default:
         break;
@@ -362,11 +911,28 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event)
 
 void SDL_AppQuit(void *appstate, SDL_AppResult result)
 {
+    stop_simulation();
+    if (Global::frameEncoder.is_running())
+    {
+        Global::frameEncoder.stop();
+        SDL_Log("captured %llu frames to %s, %llu dropped, %llu not written", static_cast<unsigned long long>(Global::frameEncoder.get_encoded_count()),
+                Global::captureDirectory, static_cast<unsigned long long>(Global::frameEncoder.get_dropped_count()),
+                static_cast<unsigned long long>(Global::frameEncoder.get_failed_count()));
+    }
+#ifdef SNAKE_ENABLE_PROFILER
+    TickProfiler::dump();
+#endif // SNAKE_ENABLE_PROFILER
+    TraceRecorder::stop();
+    if (Global::isMeasuringLatency)
+        Global::inputLatencyTracker.dump();
     if (appstate != NULL)
     {
         AppState *as = static_cast<AppState *>(appstate);
+        if (as->renderState.statusTexture != nullptr)
+            SDL_DestroyTexture(as->renderState.statusTexture);
         SDL_DestroyRenderer(as->renderer);
         SDL_DestroyWindow(as->window);
+        SDL_DestroySurface(as->captureSurface);
         delete as;
     }
 }
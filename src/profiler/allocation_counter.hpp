@@ -0,0 +1,46 @@
+#ifndef SRC_PROFILER_ALLOCATION_COUNTER_HPP
+#define SRC_PROFILER_ALLOCATION_COUNTER_HPP
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <SDL3/SDL_stdinc.h>
+
+// Counts heap allocations made through the global operator new, over the
+// whole process and per thread. The counters only move in a program that
+// expands SNAKE_DEFINE_COUNTING_OPERATOR_NEW() in exactly one translation unit.
+namespace AllocationCounter
+{
+    inline std::atomic<Uint64> allocationCount{0U};
+    inline std::atomic<Uint64> allocatedBytes{0U};
+    inline thread_local Uint64 threadAllocationCount = 0U;
+    inline thread_local Uint64 threadAllocatedBytes = 0U;
+
+    static Uint64 get_allocation_count() { return allocationCount.load(std::memory_order_relaxed); }
+    static Uint64 get_allocated_bytes() { return allocatedBytes.load(std::memory_order_relaxed); }
+    // The calling thread's share only, e.g. to time one system without the workers around it.
+    static Uint64 get_thread_allocation_count() { return threadAllocationCount; }
+    static Uint64 get_thread_allocated_bytes() { return threadAllocatedBytes; }
+
+    static void *allocate(const std::size_t &size)
+    {
+        allocationCount.fetch_add(1U, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        threadAllocationCount++;
+        threadAllocatedBytes += size;
+        void *ret = std::malloc(size == 0U ? 1U : size);
+        if (ret == nullptr)
+            throw std::bad_alloc();
+        return ret;
+    }
+} // namespace AllocationCounter
+
+// The array and nothrow forms of operator new forward to operator new(std::size_t) by default.
+#define SNAKE_DEFINE_COUNTING_OPERATOR_NEW()                                                   \
+    void *operator new(std::size_t size) { return AllocationCounter::allocate(size); }         \
+    void operator delete(void *ptr) noexcept { std::free(ptr); }                               \
+    void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }                  \
+    static_assert(true, "")
+
+#endif // SRC_PROFILER_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,88 @@
+#ifndef SRC_PROFILER_FRAME_STATS_HPP
+#define SRC_PROFILER_FRAME_STATS_HPP
+
+#include <algorithm>
+#include <array>
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+// Always-on counters behind the performance HUD. Samples accumulate in the
+// current window and become the published snapshot once WINDOW_NS has passed,
+// so readers see values that change at most once per second.
+class FrameStats
+{
+public:
+    static constexpr Uint64 WINDOW_NS = SDL_NS_PER_SECOND;
+    static constexpr size_t MAX_TICK_SAMPLES = 1024U; // ticks beyond this per window count but are not ranked
+
+    struct Snapshot
+    {
+        double ticksPerSecond;
+        double framesPerSecond;
+        Uint64 tickP99Ns;
+        Uint64 tickMaxNs;
+        Uint32 catchUpTicksMax; // most fixed ticks run by a single SDL_AppIterate
+        Uint64 allocatedBytesPerTick;
+    }; // struct Snapshot
+
+    explicit FrameStats(const Uint64 &nowNs) : windowStartNs(nowNs) {}
+
+    void add_tick(const Uint64 &durationNs, const Uint64 &allocatedBytes)
+    {
+        if (tickCount < MAX_TICK_SAMPLES)
+            tickDurationNs[tickCount] = durationNs;
+        tickCount++;
+        tickMaxNs = SDL_max(tickMaxNs, durationNs);
+        tickAllocatedBytes += allocatedBytes;
+    }
+    void add_frame() { frameCount++; }
+    void add_iterate(const Uint32 &ticksRun) { catchUpTicksMax = SDL_max(catchUpTicksMax, ticksRun); }
+
+    // Publishes the window and starts the next one if it is over; true if the snapshot changed.
+    bool update(const Uint64 &nowNs)
+    {
+        const Uint64 elapsedNs = nowNs - windowStartNs;
+        if (elapsedNs < WINDOW_NS)
+            return false;
+
+        const double elapsedSeconds = static_cast<double>(elapsedNs) / static_cast<double>(SDL_NS_PER_SECOND);
+        snapshot.ticksPerSecond = static_cast<double>(tickCount) / elapsedSeconds;
+        snapshot.framesPerSecond = static_cast<double>(frameCount) / elapsedSeconds;
+        snapshot.tickMaxNs = tickMaxNs;
+        snapshot.catchUpTicksMax = catchUpTicksMax;
+        snapshot.allocatedBytesPerTick = tickCount > 0U ? tickAllocatedBytes / tickCount : 0U;
+
+        const size_t sampleCount = SDL_min(tickCount, MAX_TICK_SAMPLES);
+        if (sampleCount > 0U)
+        { // nearest rank
+            const size_t rank = (sampleCount * 99U + 99U) / 100U - 1U;
+            std::nth_element(tickDurationNs.begin(), tickDurationNs.begin() + rank, tickDurationNs.begin() + sampleCount);
+            snapshot.tickP99Ns = tickDurationNs[rank];
+        }
+        else
+            snapshot.tickP99Ns = 0U;
+
+        windowStartNs = nowNs;
+        tickCount = 0U;
+        frameCount = 0U;
+        tickMaxNs = 0U;
+        catchUpTicksMax = 0U;
+        tickAllocatedBytes = 0U;
+        return true;
+    }
+
+    const Snapshot &get_snapshot() const { return snapshot; }
+
+private:
+    Snapshot snapshot{};
+    Uint64 windowStartNs;
+    std::array<Uint64, MAX_TICK_SAMPLES> tickDurationNs{};
+    size_t tickCount = 0U;
+    Uint64 frameCount = 0U;
+    Uint64 tickMaxNs = 0U;
+    Uint32 catchUpTicksMax = 0U;
+    Uint64 tickAllocatedBytes = 0U;
+}; // class FrameStats
+
+#endif // SRC_PROFILER_FRAME_STATS_HPP
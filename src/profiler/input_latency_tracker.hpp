@@ -0,0 +1,147 @@
+#ifndef SRC_PROFILER_INPUT_LATENCY_TRACKER_HPP
+#define SRC_PROFILER_INPUT_LATENCY_TRACKER_HPP
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+// Follows one movement key at a time from its SDL event timestamp to the
+// SDL_RenderPresent() that first shows the turn, and keeps the latency of every
+// stage measured from the event timestamp. All times are SDL_GetTicksNS() based,
+// like SDL_KeyboardEvent::timestamp. A key that never turns the snake (same or
+// reversed direction) is abandoned when the next key arrives or after TIMEOUT_NS.
+class InputLatencyTracker
+{
+public:
+    enum Stage : Uint8
+    {
+        KEY_CONTROL = 0U, // the key was handed to the gameplay, e.g. queued for the simulation thread
+        VELOCITY,         // first tick seen where the head Velocity changed
+        BOARD_FRAME,      // first rendered board with the head in a new cell since that tick
+        PRESENT,          // SDL_RenderPresent() of that frame returned
+
+        STAGE_END,
+    }; // enum Stage
+
+    static constexpr const char *STAGE_NAMES[STAGE_END] = {"key_control", "velocity", "board_frame", "present"};
+    static constexpr size_t MAX_SAMPLES = 4096U; // per stage; the oldest samples are overwritten
+    static constexpr Uint64 TIMEOUT_NS = SDL_NS_PER_SECOND;
+
+    struct Summary
+    {
+        size_t count;
+        Uint64 p50Ns;
+        Uint64 p90Ns;
+        Uint64 p99Ns;
+        Uint64 maxNs;
+    }; // struct Summary
+
+    InputLatencyTracker()
+    {
+        for (auto &stageSamples : samples)
+            stageSamples.reserve(MAX_SAMPLES);
+    }
+
+    void on_key_down(const Uint64 &eventNs, const float &velocityX, const float &velocityY)
+    {
+        if (isPending)
+            abandonedCount++;
+        isPending = true;
+        nextStage = KEY_CONTROL;
+        keyEventNs = eventNs;
+        previousVelocityX = velocityX;
+        previousVelocityY = velocityY;
+    }
+
+    void on_key_control(const Uint64 &nowNs) { advance(KEY_CONTROL, nowNs); }
+
+    // After every simulation tick.
+    void on_tick(const float &velocityX, const float &velocityY, const long &headCell, const Uint64 &nowNs)
+    {
+        if (!isPending)
+            return;
+        if (nowNs - keyEventNs > TIMEOUT_NS)
+        {
+            isPending = false;
+            abandonedCount++;
+            return;
+        }
+        if (nextStage == VELOCITY && (velocityX != previousVelocityX || velocityY != previousVelocityY))
+        {
+            turnHeadCell = headCell;
+            advance(VELOCITY, nowNs);
+        }
+    }
+
+    // After a board is drawn, before it is presented.
+    void on_frame(const long &headCell, const Uint64 &nowNs)
+    {
+        if (isPending && nextStage == BOARD_FRAME && headCell != turnHeadCell)
+            advance(BOARD_FRAME, nowNs);
+    }
+
+    void on_present(const Uint64 &nowNs) { advance(PRESENT, nowNs); }
+
+    Summary get_summary(const Stage &stage) const
+    {
+        Summary ret{samples[stage].size(), 0U, 0U, 0U, 0U};
+        if (ret.count == 0U)
+            return ret;
+        std::vector<Uint64> sorted(samples[stage]);
+        std::sort(sorted.begin(), sorted.end());
+        auto getPercentile = [&sorted](const size_t &percent)
+        { return sorted[(sorted.size() * percent + 99U) / 100U - 1U]; }; // nearest rank
+        ret.p50Ns = getPercentile(50U);
+        ret.p90Ns = getPercentile(90U);
+        ret.p99Ns = getPercentile(99U);
+        ret.maxNs = sorted.back();
+        return ret;
+    }
+    size_t get_abandoned_count() const { return abandonedCount; }
+
+    void dump() const
+    {
+        SDL_Log("input latency from key event, %zu inputs abandoned", abandonedCount);
+        SDL_Log("%-12s %8s %10s %10s %10s %10s", "stage", "count", "p50_ms", "p90_ms", "p99_ms", "max_ms");
+        for (int stage = 0; stage < STAGE_END; stage++)
+        {
+            const Summary summary = get_summary(static_cast<Stage>(stage));
+            SDL_Log("%-12s %8zu %10.2f %10.2f %10.2f %10.2f", STAGE_NAMES[stage], summary.count,
+                    summary.p50Ns / 1000000.0, summary.p90Ns / 1000000.0, summary.p99Ns / 1000000.0, summary.maxNs / 1000000.0);
+        }
+    }
+
+private:
+    void advance(const Stage &stage, const Uint64 &nowNs)
+    {
+        if (!isPending || nextStage != stage)
+            return;
+        std::vector<Uint64> &stageSamples = samples[stage];
+        const Uint64 latencyNs = nowNs > keyEventNs ? nowNs - keyEventNs : 0U;
+        if (stageSamples.size() < MAX_SAMPLES)
+            stageSamples.push_back(latencyNs);
+        else
+            stageSamples[sampleCounts[stage] % MAX_SAMPLES] = latencyNs;
+        sampleCounts[stage]++;
+
+        nextStage = static_cast<Stage>(stage + 1);
+        isPending = nextStage != STAGE_END;
+    }
+
+    std::array<std::vector<Uint64>, STAGE_END> samples;
+    std::array<size_t, STAGE_END> sampleCounts{};
+    size_t abandonedCount = 0U;
+
+    bool isPending = false;
+    Stage nextStage = KEY_CONTROL;
+    Uint64 keyEventNs = 0U;
+    float previousVelocityX = 0.0f;
+    float previousVelocityY = 0.0f;
+    long turnHeadCell = -1L;
+}; // class InputLatencyTracker
+
+#endif // SRC_PROFILER_INPUT_LATENCY_TRACKER_HPP
@@ -0,0 +1,226 @@
+#ifndef SRC_PROFILER_TICK_PROFILER_HPP
+#define SRC_PROFILER_TICK_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+// Scoped high-resolution timers feeding per-thread latency histograms.
+// Each thread records into its own histograms (single writer, relaxed atomics,
+// no locks), and readers merge every thread's histograms on demand.
+// Instrumentation goes through SNAKE_PROFILE_SCOPE(), which compiles to nothing
+// unless SNAKE_ENABLE_PROFILER is defined (CMake option of the same name).
+namespace TickProfiler
+{
+    enum Phase : Uint8
+    {
+        TICK = 0U,          // one Global::GameplayPipeline::iterate
+        TRANSLATE_2D,       // SystemTranslate2D::iterate
+        HAMILTONIAN_SOLVER, // SnakeHamiltonianSolver::iterate
+        GAMEPLAY,           // SnakeGameplaySystem::iterate
+        APPLE_UPDATE,       // SnakeGameplaySystem::Detail::apple_update
+        DO_TRAILING,        // SnakeGameplaySystem::Detail::do_trailing
+        COLLISION_CHECK,    // SnakeGameplaySystem::is_game_success and is_game_failure
+        GET_MAP,            // SnakeGameplaySystem::get_map
+        RENDER,             // render_gameplay_visuals
+
+        PHASE_END,
+    }; // enum Phase
+
+    static constexpr const char *PHASE_NAMES[PHASE_END] = {
+        "tick", "translate_2d", "hamiltonian_solver", "gameplay", "apple_update",
+        "do_trailing", "collision_check", "get_map", "render"};
+
+    // Log-linear buckets: 8 per power of two, i.e. <= 12.5% error, from 0 ns up to 2^MAX_EXPONENT ns.
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 40; // ~18 minutes; longer samples land in the last bucket
+    static constexpr int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    struct Histogram
+    {
+        std::array<std::atomic<Uint64>, BUCKET_COUNT> buckets{};
+        std::atomic<Uint64> count{0U};
+        std::atomic<Uint64> totalNs{0U};
+        std::atomic<Uint64> maxNs{0U};
+    }; // struct Histogram
+
+    struct ThreadData
+    {
+        std::array<Histogram, PHASE_END> histograms;
+    }; // struct ThreadData
+
+    struct Summary
+    {
+        Uint64 count;
+        Uint64 meanNs;
+        Uint64 p50Ns;
+        Uint64 p99Ns;
+        Uint64 maxNs;
+    }; // struct Summary
+
+    // Thread data is never freed so that samples of finished threads still show up in dumps.
+    inline std::mutex threadDataMutex;
+    inline std::vector<std::unique_ptr<ThreadData>> threadDataArray;
+
+    namespace Detail
+    {
+        static int get_bucket_index(const Uint64 &ns)
+        {
+            if (ns < static_cast<Uint64>(SUB_BUCKET_COUNT))
+                return static_cast<int>(ns);
+            int exponent = 63;
+            while ((ns >> exponent) == 0U)
+                exponent--;
+            if (exponent >= MAX_EXPONENT)
+                return BUCKET_COUNT - 1;
+            const int subBucket = static_cast<int>((ns >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1));
+            return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+        }
+
+        // Largest value that falls into the bucket.
+        static Uint64 get_bucket_upper_bound(const int &index)
+        {
+            if (index < SUB_BUCKET_COUNT)
+                return static_cast<Uint64>(index);
+            const int exponent = index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+            const Uint64 subBucket = static_cast<Uint64>(index % SUB_BUCKET_COUNT);
+            const int shift = exponent - SUB_BUCKET_BITS;
+            return ((static_cast<Uint64>(SUB_BUCKET_COUNT) + subBucket + 1U) << shift) - 1U;
+        }
+
+        static void add(std::atomic<Uint64> &counter, const Uint64 &value)
+        { // single writer per thread, so a plain load/store pair is enough
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        static ThreadData *register_thread()
+        {
+            std::lock_guard<std::mutex> lock(threadDataMutex);
+            threadDataArray.push_back(std::make_unique<ThreadData>());
+            return threadDataArray.back().get();
+        }
+
+        static ThreadData &get_thread_data()
+        {
+            thread_local ThreadData *threadData = register_thread();
+            return *threadData;
+        }
+
+        static Uint64 get_ns_from_counter(const Uint64 &counterDelta)
+        {
+            static const Uint64 frequency = SDL_GetPerformanceFrequency();
+            return counterDelta / frequency * SDL_NS_PER_SECOND + counterDelta % frequency * SDL_NS_PER_SECOND / frequency;
+        }
+    } // namespace Detail
+
+    static void record(const Phase &phase, const Uint64 &ns)
+    {
+        Histogram &histogram = Detail::get_thread_data().histograms[phase];
+        Detail::add(histogram.buckets[Detail::get_bucket_index(ns)], 1U);
+        Detail::add(histogram.count, 1U);
+        Detail::add(histogram.totalNs, ns);
+        if (ns > histogram.maxNs.load(std::memory_order_relaxed))
+            histogram.maxNs.store(ns, std::memory_order_relaxed);
+    }
+
+    // Merges every thread's histogram of the phase; percentiles are bucket upper bounds capped at the max.
+    static Summary get_summary(const Phase &phase)
+    {
+        std::array<Uint64, BUCKET_COUNT> buckets{};
+        Summary ret{0U, 0U, 0U, 0U, 0U};
+        Uint64 totalNs = 0U;
+        {
+            std::lock_guard<std::mutex> lock(threadDataMutex);
+            for (const auto &threadData : threadDataArray)
+            {
+                const Histogram &histogram = threadData->histograms[phase];
+                for (int i = 0; i < BUCKET_COUNT; i++)
+                    buckets[i] += histogram.buckets[i].load(std::memory_order_relaxed);
+                totalNs += histogram.totalNs.load(std::memory_order_relaxed);
+                ret.maxNs = SDL_max(ret.maxNs, histogram.maxNs.load(std::memory_order_relaxed));
+            }
+        }
+        for (const Uint64 &bucket : buckets)
+            ret.count += bucket;
+        if (ret.count == 0U)
+            return ret;
+
+        ret.meanNs = totalNs / ret.count;
+        auto getPercentile = [&](const Uint64 &percent)
+        {
+            const Uint64 rank = (ret.count * percent + 99U) / 100U; // nearest rank
+            Uint64 seen = 0U;
+            for (int i = 0; i < BUCKET_COUNT; i++)
+            {
+                seen += buckets[i];
+                if (seen >= rank)
+                    return SDL_min(Detail::get_bucket_upper_bound(i), ret.maxNs);
+            }
+            return ret.maxNs;
+        };
+        ret.p50Ns = getPercentile(50U);
+        ret.p99Ns = getPercentile(99U);
+        return ret;
+    }
+
+    // NOTE: not synchronised with writers; call while no phase is being timed.
+    static void reset()
+    {
+        std::lock_guard<std::mutex> lock(threadDataMutex);
+        for (const auto &threadData : threadDataArray)
+        {
+            for (Histogram &histogram : threadData->histograms)
+            {
+                for (auto &bucket : histogram.buckets)
+                    bucket.store(0U, std::memory_order_relaxed);
+                histogram.count.store(0U, std::memory_order_relaxed);
+                histogram.totalNs.store(0U, std::memory_order_relaxed);
+                histogram.maxNs.store(0U, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static void dump()
+    {
+        SDL_Log("%-20s %10s %10s %10s %10s %10s", "phase", "count", "mean_us", "p50_us", "p99_us", "max_us");
+        for (int phase = 0; phase < PHASE_END; phase++)
+        {
+            const Summary summary = get_summary(static_cast<Phase>(phase));
+            if (summary.count == 0U)
+                continue;
+            SDL_Log("%-20s %10llu %10.1f %10.1f %10.1f %10.1f", PHASE_NAMES[phase], static_cast<unsigned long long>(summary.count),
+                    summary.meanNs / 1000.0, summary.p50Ns / 1000.0, summary.p99Ns / 1000.0, summary.maxNs / 1000.0);
+        }
+    }
+
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(const Phase &phase) : phase(phase), start(SDL_GetPerformanceCounter()) {}
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+        ~ScopedTimer() { record(phase, Detail::get_ns_from_counter(SDL_GetPerformanceCounter() - start)); }
+
+    private:
+        Phase phase;
+        Uint64 start;
+    }; // class ScopedTimer
+} // namespace TickProfiler
+
+#define SNAKE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SNAKE_PROFILE_CONCAT(a, b) SNAKE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef SNAKE_ENABLE_PROFILER
+#define SNAKE_PROFILE_SCOPE(phase) const TickProfiler::ScopedTimer SNAKE_PROFILE_CONCAT(snakeProfileTimer, __LINE__)(phase)
+#else
+#define SNAKE_PROFILE_SCOPE(phase) ((void)0)
+#endif // SNAKE_ENABLE_PROFILER
+
+#endif // SRC_PROFILER_TICK_PROFILER_HPP
@@ -0,0 +1,186 @@
+#ifndef SRC_PROFILER_TRACE_RECORDER_HPP
+#define SRC_PROFILER_TRACE_RECORDER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
+
+// Timeline of scopes written as a Chrome trace-event JSON file
+// (chrome://tracing, ui.perfetto.dev). Recording is opt-in at run time: while
+// stopped a scope costs one relaxed load. While recording, a scope is two
+// performance counter reads plus, at its exit, one complete ('X') event
+// stored into the calling thread's preallocated ring; a background thread
+// drains every ring into the file. A full ring drops whole scopes (see
+// get_dropped_count()) instead of blocking, so nesting stays well-formed.
+namespace TraceRecorder
+{
+    static constexpr size_t RING_CAPACITY = 1U << 14; // events per thread, MUST BE a power of 2
+    static constexpr Uint64 FLUSH_PERIOD_MS = 10U;
+
+    struct Event
+    {
+        const char *name; // MUST have static storage duration, e.g. a string literal
+        Uint64 counter;   // SDL_GetPerformanceCounter() at scope entry
+        Uint64 duration;  // in performance counter ticks
+    }; // struct Event
+
+    struct ThreadRing
+    {
+        Uint32 threadId;
+        std::array<Event, RING_CAPACITY> events;
+        alignas(64) std::atomic<Uint64> head{0U}; // written by the owning thread
+        alignas(64) std::atomic<Uint64> tail{0U}; // written by the flush thread
+    }; // struct ThreadRing
+
+    inline std::atomic<bool> isRecording{false};
+    inline std::atomic<Uint64> droppedCount{0U};
+
+    // Rings are never freed so that events of finished threads can still be flushed.
+    inline std::mutex ringMutex;
+    inline std::vector<std::unique_ptr<ThreadRing>> ringArray;
+
+    inline std::mutex flushMutex;
+    inline std::condition_variable flushCondition;
+    inline std::thread flushThread;
+    inline bool isStopRequested = false;
+    inline std::FILE *file = nullptr;
+    inline bool isFirstEvent = true;
+    inline Uint64 startCounter = 0U;
+
+    namespace Detail
+    {
+        static ThreadRing *register_thread()
+        {
+            std::lock_guard<std::mutex> lock(ringMutex);
+            ringArray.push_back(std::make_unique<ThreadRing>());
+            ringArray.back()->threadId = static_cast<Uint32>(ringArray.size());
+            return ringArray.back().get();
+        }
+
+        static ThreadRing &get_thread_ring()
+        {
+            thread_local ThreadRing *ring = register_thread();
+            return *ring;
+        }
+
+        static void push(const char *name, const Uint64 &counter, const Uint64 &duration)
+        {
+            ThreadRing &ring = get_thread_ring();
+            const Uint64 head = ring.head.load(std::memory_order_relaxed);
+            if (head - ring.tail.load(std::memory_order_acquire) >= RING_CAPACITY)
+            {
+                droppedCount.fetch_add(1U, std::memory_order_relaxed);
+                return;
+            }
+            ring.events[head & (RING_CAPACITY - 1U)] = Event{name, counter, duration};
+            ring.head.store(head + 1U, std::memory_order_release);
+        }
+
+        // Flush thread only, with flushMutex held.
+        static void drain(const bool &isWriting)
+        {
+            static const double counterToUs = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+            std::lock_guard<std::mutex> lock(ringMutex);
+            for (const auto &ring : ringArray)
+            {
+                const Uint64 head = ring->head.load(std::memory_order_acquire);
+                Uint64 tail = ring->tail.load(std::memory_order_relaxed);
+                for (; isWriting && tail != head; tail++)
+                {
+                    const Event &event = ring->events[tail & (RING_CAPACITY - 1U)];
+                    const double ts = static_cast<double>(static_cast<Sint64>(event.counter - startCounter)) * counterToUs;
+                    const double dur = static_cast<double>(event.duration) * counterToUs;
+                    std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                                 isFirstEvent ? "\n" : ",\n", event.name, ts, dur, static_cast<unsigned>(ring->threadId));
+                    isFirstEvent = false;
+                }
+                ring->tail.store(head, std::memory_order_release);
+            }
+        }
+
+        static void flush_loop()
+        {
+            std::unique_lock<std::mutex> lock(flushMutex);
+            while (!isStopRequested)
+            {
+                flushCondition.wait_for(lock, std::chrono::milliseconds(FLUSH_PERIOD_MS));
+                drain(true);
+            }
+        }
+    } // namespace Detail
+
+    static bool is_recording() { return isRecording.load(std::memory_order_relaxed); }
+    static Uint64 get_dropped_count() { return droppedCount.load(std::memory_order_relaxed); }
+
+    // Starts writing a new trace to path; false if already recording or the file cannot be opened.
+    static bool start(const char *path)
+    {
+        std::lock_guard<std::mutex> lock(flushMutex);
+        if (file != nullptr)
+            return false;
+        file = std::fopen(path, "w");
+        if (file == nullptr)
+            return false;
+        std::fputs("[", file);
+        isFirstEvent = true;
+        isStopRequested = false;
+        startCounter = SDL_GetPerformanceCounter();
+        droppedCount.store(0U, std::memory_order_relaxed);
+        Detail::drain(false); // stale events of an earlier recording
+        isRecording.store(true, std::memory_order_release);
+        flushThread = std::thread(Detail::flush_loop);
+        return true;
+    }
+
+    // Writes the remaining events and closes the file.
+    static void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(flushMutex);
+            if (file == nullptr)
+                return;
+            isRecording.store(false, std::memory_order_release);
+            isStopRequested = true;
+        }
+        flushCondition.notify_all();
+        flushThread.join();
+
+        std::lock_guard<std::mutex> lock(flushMutex);
+        Detail::drain(true);
+        std::fputs("\n]\n", file);
+        std::fclose(file);
+        file = nullptr;
+    }
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char *name) : name(name), startCounter(is_recording() ? SDL_GetPerformanceCounter() : 0U) {}
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+        ~Scope()
+        {
+            if (startCounter != 0U) // records the scope even if recording stops in between
+                Detail::push(name, startCounter, SDL_GetPerformanceCounter() - startCounter);
+        }
+
+    private:
+        const char *name;
+        Uint64 startCounter; // 0 when the scope began while stopped
+    }; // class Scope
+} // namespace TraceRecorder
+
+#define SNAKE_TRACE_CONCAT_IMPL(a, b) a##b
+#define SNAKE_TRACE_CONCAT(a, b) SNAKE_TRACE_CONCAT_IMPL(a, b)
+#define SNAKE_TRACE_SCOPE(name) const TraceRecorder::Scope SNAKE_TRACE_CONCAT(snakeTraceScope, __LINE__)(name)
+
+#endif // SRC_PROFILER_TRACE_RECORDER_HPP
@@ -0,0 +1,96 @@
+#ifndef SRC_RENDER_BOARD_SNAPSHOT_HPP
+#define SRC_RENDER_BOARD_SNAPSHOT_HPP
+
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+#include <entt/entt.hpp>
+
+#include <component/position.hpp>
+#include <component/snake_apple.hpp>
+#include <component/snake_boundary_2d.hpp>
+#include <component/snake_part.hpp>
+#include <component/snake_part_head.hpp>
+#include <component/velocity.hpp>
+
+#include <system/snake_gameplay_system.hpp>
+
+// Everything the main thread draws, copied out of the simulation's registry
+// after a tick so that rendering never touches the registry. Capturing into
+// the same snapshot again reuses its board and does not allocate.
+struct BoardSnapshot
+{
+    enum Status : Uint8
+    {
+        PLAYING = 0U,
+        SUCCESS,
+        FAILURE,
+    }; // enum Status
+
+    struct EntityCounts
+    {
+        Uint32 position;
+        Uint32 velocity;
+        Uint32 head;
+        Uint32 part;
+        Uint32 apple;
+    }; // struct EntityCounts
+
+    Uint64 revision = 0U;  // changes whenever anything drawn changes, see is_same_view()
+    Uint64 tickCount = 0U; // fixed ticks run before the capture
+    Uint64 capturedNs = 0U;
+
+    int width = 0;
+    int height = 0;
+    std::vector<Uint8> board; // see SnakeGameplaySystem::get_board()
+    unsigned long score = 0UL;
+    Status status = PLAYING;
+    bool isPaused = false;
+
+    long headCell = -1L; // y * width + x
+    Velocity headVelocity = {0.0f, 0.0f};
+    EntityCounts entityCounts = {0U, 0U, 0U, 0U, 0U};
+
+    // Fills every field from reg but revision, tickCount, capturedNs and isPaused.
+    void capture(entt::registry &reg)
+    {
+        auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
+        SDL_assert(snakeBoundaryView.size() == 1);
+        const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
+        width = boundary.x;
+        height = boundary.y;
+        board.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
+        SnakeGameplaySystem::get_board(reg, board.data());
+
+        score = SnakeGameplaySystem::get_score(reg);
+        if (SnakeGameplaySystem::is_game_success(reg))
+            status = SUCCESS;
+        else if (SnakeGameplaySystem::is_game_failure(reg))
+            status = FAILURE;
+        else
+            status = PLAYING;
+
+        long xIndex, yIndex;
+        SnakeGameplaySystem::Util::get_index_from_pos(SnakeGameplaySystem::Debug::get_snake_head_pos(reg), &xIndex, &yIndex, height);
+        headCell = yIndex * width + xIndex;
+        headVelocity = SnakeGameplaySystem::Debug::get_snake_head_velocity(reg);
+
+        entityCounts.position = static_cast<Uint32>(reg.view<Position>().size());
+        entityCounts.velocity = static_cast<Uint32>(reg.view<Velocity>().size());
+        entityCounts.head = static_cast<Uint32>(reg.view<SnakePartHead>().size());
+        entityCounts.part = static_cast<Uint32>(reg.view<SnakePart>().size());
+        entityCounts.apple = static_cast<Uint32>(reg.view<SnakeApple>().size());
+    }
+
+    // True if both draw the same board, score and status text.
+    bool is_same_view(const BoardSnapshot &other) const
+    {
+        return width == other.width && height == other.height && board == other.board &&
+               score == other.score && status == other.status && isPaused == other.isPaused;
+    }
+
+    bool is_idle() const { return isPaused || status != PLAYING; }
+}; // struct BoardSnapshot
+
+#endif // SRC_RENDER_BOARD_SNAPSHOT_HPP
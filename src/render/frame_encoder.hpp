@@ -0,0 +1,241 @@
+#ifndef SRC_RENDER_FRAME_ENCODER_HPP
+#define SRC_RENDER_FRAME_ENCODER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_endian.h>
+#include <SDL3/SDL_log.h>
+#include <SDL3/SDL_stdinc.h>
+
+// Writes captured frames to numbered files on a background thread. push()
+// copies a frame into one of a fixed number of preallocated slots and returns
+// at once; when every slot is still waiting for the encoder the frame is
+// dropped instead, so a slow disk never stalls the caller.
+//
+// Input frames are width * height XRGB8888 pixels. Files are
+// <directory>/frame_<6-digit index>.<format name>, indices counting from 0:
+//   PPM: binary "P6" image;
+//   RAW: width * height * 3 bytes of RGB, as for ffmpeg -f rawvideo -pixel_format rgb24;
+//   RLE: "SRLE", width and height as little-endian Uint32, then (count 1..255, R, G, B) runs.
+class FrameEncoder
+{
+public:
+    enum Format : Uint8
+    {
+        PPM = 0U,
+        RAW,
+        RLE,
+
+        FORMAT_END,
+    }; // enum Format
+
+    static constexpr const char *FORMAT_NAMES[FORMAT_END] = {"ppm", "raw", "rle"}; // also the file extensions
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 8U;
+
+    FrameEncoder() = default;
+    FrameEncoder(const FrameEncoder &) = delete;
+    FrameEncoder &operator=(const FrameEncoder &) = delete;
+    ~FrameEncoder() { stop(); }
+
+    static bool parse_format(const char *name, Format *format)
+    {
+        SDL_assert(name != nullptr && format != nullptr);
+        for (int i = 0; i < FORMAT_END; i++)
+        {
+            if (std::strcmp(name, FORMAT_NAMES[i]) == 0)
+            {
+                *format = static_cast<Format>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Allocates every slot up front; false if already running or the size is empty.
+    bool start(const std::string &directory, const Format &format, const int &width, const int &height,
+               const size_t &queueCapacity = DEFAULT_QUEUE_CAPACITY)
+    {
+        if (encoderThread.joinable() || width <= 0 || height <= 0 || queueCapacity == 0U || format >= FORMAT_END)
+            return false;
+        this->directory = directory;
+        this->format = format;
+        this->width = width;
+        this->height = height;
+
+        const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+        slots.assign(queueCapacity, std::vector<Uint32>(pixelCount));
+        freeSlots.clear();
+        for (size_t i = 0U; i < queueCapacity; i++)
+            freeSlots.push_back(queueCapacity - 1U - i);
+        readySlots.assign(queueCapacity, 0U);
+        readyHead = 0U;
+        readyCount = 0U;
+        encodeBuffer.resize(pixelCount * 4U); // RLE worst case: one run per pixel
+        encodedCount.store(0U, std::memory_order_relaxed);
+        droppedCount.store(0U, std::memory_order_relaxed);
+        failedCount.store(0U, std::memory_order_relaxed);
+        isStopRequested = false;
+        encoderThread = std::thread(&FrameEncoder::encode_loop, this);
+        return true;
+    }
+
+    // Encodes every frame already pushed, then joins the encoder thread.
+    void stop()
+    {
+        if (!encoderThread.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopRequested = true;
+        }
+        condition.notify_one();
+        encoderThread.join();
+    }
+
+    bool is_running() const { return encoderThread.joinable(); }
+
+    // Producer thread only; rows of pitch bytes. false if the frame was dropped.
+    bool push(const void *pixels, const int &pitch)
+    {
+        SDL_assert(pixels != nullptr && is_running());
+        size_t slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (freeSlots.empty())
+            {
+                droppedCount.fetch_add(1U, std::memory_order_relaxed);
+                return false;
+            }
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        const size_t rowSize = static_cast<size_t>(width) * sizeof(Uint32);
+        const Uint8 *source = static_cast<const Uint8 *>(pixels);
+        Uint8 *destination = reinterpret_cast<Uint8 *>(slots[slot].data());
+        if (static_cast<size_t>(pitch) == rowSize)
+            std::memcpy(destination, source, rowSize * static_cast<size_t>(height));
+        else
+        {
+            for (int y = 0; y < height; y++)
+                std::memcpy(destination + y * rowSize, source + static_cast<size_t>(y) * pitch, rowSize);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            readySlots[(readyHead + readyCount) % readySlots.size()] = slot;
+            readyCount++;
+        }
+        condition.notify_one();
+        return true;
+    }
+
+    Uint64 get_encoded_count() const { return encodedCount.load(std::memory_order_relaxed); }
+    Uint64 get_dropped_count() const { return droppedCount.load(std::memory_order_relaxed); }
+    Uint64 get_failed_count() const { return failedCount.load(std::memory_order_relaxed); }
+
+private:
+    void encode_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            condition.wait(lock, [this]()
+                           { return isStopRequested || readyCount > 0U; });
+            if (readyCount == 0U)
+                return; // stop requested and drained
+            const size_t slot = readySlots[readyHead];
+            readyHead = (readyHead + 1U) % readySlots.size();
+            readyCount--;
+            lock.unlock();
+
+            if (!write_frame(slots[slot]))
+                failedCount.fetch_add(1U, std::memory_order_relaxed);
+            encodedCount.fetch_add(1U, std::memory_order_relaxed);
+
+            lock.lock();
+            freeSlots.push_back(slot);
+        }
+    }
+
+    // Encoder thread only.
+    bool write_frame(const std::vector<Uint32> &pixels)
+    {
+        size_t size = 0U;
+        Uint8 *out = encodeBuffer.data();
+        if (format == RLE)
+        {
+            for (size_t i = 0U; i < pixels.size();)
+            {
+                const Uint32 pixel = pixels[i] & 0x00FFFFFFU;
+                size_t run = 1U;
+                while (run < 255U && i + run < pixels.size() && (pixels[i + run] & 0x00FFFFFFU) == pixel)
+                    run++;
+                out[size++] = static_cast<Uint8>(run);
+                out[size++] = static_cast<Uint8>(pixel >> 16);
+                out[size++] = static_cast<Uint8>(pixel >> 8);
+                out[size++] = static_cast<Uint8>(pixel);
+                i += run;
+            }
+        }
+        else
+        {
+            for (const Uint32 &pixel : pixels)
+            {
+                out[size++] = static_cast<Uint8>(pixel >> 16);
+                out[size++] = static_cast<Uint8>(pixel >> 8);
+                out[size++] = static_cast<Uint8>(pixel);
+            }
+        }
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "/frame_%06llu.", static_cast<unsigned long long>(get_encoded_count()));
+        const std::string path = directory + name + FORMAT_NAMES[format];
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr)
+        {
+            SDL_Log("FrameEncoder: cannot write %s", path.c_str());
+            return false;
+        }
+        bool ret = true;
+        if (format == PPM)
+            ret = std::fprintf(file, "P6\n%d %d\n255\n", width, height) > 0;
+        else if (format == RLE)
+        {
+            const Uint32 header[2] = {SDL_Swap32LE(static_cast<Uint32>(width)), SDL_Swap32LE(static_cast<Uint32>(height))};
+            ret = std::fwrite("SRLE", 1U, 4U, file) == 4U && std::fwrite(header, sizeof(header), 1U, file) == 1U;
+        }
+        ret = ret && std::fwrite(out, 1U, size, file) == size;
+        return std::fclose(file) == 0 && ret;
+    }
+
+    std::string directory;
+    Format format = PPM;
+    int width = 0;
+    int height = 0;
+
+    std::mutex mutex; // guards freeSlots, readySlots, readyHead, readyCount and isStopRequested
+    std::condition_variable condition;
+    std::vector<std::vector<Uint32>> slots;
+    std::vector<size_t> freeSlots;
+    std::vector<size_t> readySlots; // ring of queued slots
+    size_t readyHead = 0U;
+    size_t readyCount = 0U;
+    bool isStopRequested = false;
+    std::thread encoderThread;
+
+    std::vector<Uint8> encodeBuffer; // encoder thread only
+    std::atomic<Uint64> encodedCount{0U};
+    std::atomic<Uint64> droppedCount{0U};
+    std::atomic<Uint64> failedCount{0U};
+}; // class FrameEncoder
+
+#endif // SRC_RENDER_FRAME_ENCODER_HPP
@@ -0,0 +1,147 @@
+#ifndef SRC_RENDER_TERMINAL_RENDERER_HPP
+#define SRC_RENDER_TERMINAL_RENDERER_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+
+#include <system/snake_gameplay_system.hpp>
+
+// Draws boards on an ANSI terminal. It remembers the last frame it drew and
+// emits only cursor moves and glyphs for the cells that changed, so a frame
+// of a moving snake is a few dozen bytes whatever the board size. Every cell
+// is two columns wide, with the glyphs of SnakeGameplaySystem::Debug::print_map().
+class TerminalRenderer
+{
+public:
+    TerminalRenderer() { output.reserve(4096U); }
+
+    // Returns the bytes that turn the last drawn frame into this one. board is
+    // height * width MapSlotState bytes, row 0 at the top, see SnakeGameplaySystem::get_board().
+    const std::string &draw(const Uint8 *board, const int &width, const int &height, const char *statusText)
+    {
+        SDL_assert(board != nullptr && statusText != nullptr && width > 0 && height > 0);
+        output.clear();
+        if (width != lastWidth || height != lastHeight)
+        {
+            output += "\x1b[?25l\x1b[0m\x1b[2J"; // hide the cursor, reset the style, clear the screen
+            lastWidth = width;
+            lastHeight = height;
+            lastBoard.assign(static_cast<size_t>(width) * static_cast<size_t>(height), INVALID_SLOT);
+            isStatusTextDrawn = false;
+            cursorRow = -1;
+            cursorColumn = -1;
+            style = STYLE_END;
+        }
+
+        for (int i = 0; i < height; i++)
+        {
+            for (int j = 0; j < width; j++)
+            {
+                const size_t index = static_cast<size_t>(i) * width + j;
+                if (board[index] == lastBoard[index])
+                    continue;
+                lastBoard[index] = board[index];
+                const Style slotStyle = get_style(board[index]);
+                move_to(i + 1, 2 * j + 1);
+                set_style(slotStyle);
+                output += GLYPHS[slotStyle];
+                output += ' ';
+                cursorColumn += 2;
+            }
+        }
+
+        if (!isStatusTextDrawn || lastStatusText != statusText)
+        {
+            isStatusTextDrawn = true;
+            lastStatusText = statusText;
+            move_to(height + 2, 1);
+            set_style(DEFAULT);
+            output += "\x1b[2K"; // erase the old text
+            output += statusText;
+            cursorColumn = -1; // not tracked through arbitrary text
+        }
+        return output;
+    }
+
+    // Writes the last draw() with a single fwrite(); false on a write error.
+    bool present(std::FILE *file) const
+    {
+        SDL_assert(file != nullptr);
+        if (output.empty())
+            return true;
+        return std::fwrite(output.data(), 1U, output.size(), file) == output.size() && std::fflush(file) == 0;
+    }
+
+    // Resets the style, shows the cursor and leaves it below the status text.
+    void restore(std::FILE *file) const
+    {
+        SDL_assert(file != nullptr);
+        std::fprintf(file, "\x1b[0m\x1b[?25h\x1b[%d;1H\n", lastHeight + 2);
+        std::fflush(file);
+    }
+
+private:
+    enum Style : Uint8
+    {
+        DEFAULT = 0U,
+        EMPTY,
+        SNAKE_HEAD,
+        SNAKE_BODY,
+        APPLE,
+        OBSTACLE,
+
+        STYLE_END,
+    }; // enum Style
+
+    static constexpr const char *STYLE_SEQUENCES[STYLE_END] = {"\x1b[0m", "\x1b[90m", "\x1b[34m", "\x1b[32m", "\x1b[31m", "\x1b[37m"};
+    static constexpr char GLYPHS[STYLE_END] = {' ', '.', '$', 'x', '@', '#'};
+    static constexpr Uint8 INVALID_SLOT = 0xFFU; // differs from every MapSlotState
+
+    static Style get_style(const Uint8 &slot)
+    { // a head on an apple, or crashed into an obstacle, is still drawn as the head
+        if (slot & SnakeGameplaySystem::SNAKE_HEAD)
+            return SNAKE_HEAD;
+        if (slot & SnakeGameplaySystem::SNAKE_BODY)
+            return SNAKE_BODY;
+        if (slot & SnakeGameplaySystem::APPLE)
+            return APPLE;
+        if (slot & SnakeGameplaySystem::OBSTACLE)
+            return OBSTACLE;
+        return EMPTY;
+    }
+
+    void move_to(const int &row, const int &column)
+    {
+        if (row == cursorRow && column == cursorColumn)
+            return; // e.g. the next cell of a run of changes
+        char sequence[32];
+        std::snprintf(sequence, sizeof(sequence), "\x1b[%d;%dH", row, column);
+        output += sequence;
+        cursorRow = row;
+        cursorColumn = column;
+    }
+
+    void set_style(const Style &newStyle)
+    {
+        if (newStyle == style)
+            return;
+        output += STYLE_SEQUENCES[newStyle];
+        style = newStyle;
+    }
+
+    std::string output;
+    std::vector<Uint8> lastBoard;
+    std::string lastStatusText;
+    bool isStatusTextDrawn = false;
+    int lastWidth = 0;
+    int lastHeight = 0;
+    int cursorRow = -1; // 1-based, -1 if unknown
+    int cursorColumn = -1;
+    Style style = STYLE_END;
+}; // class TerminalRenderer
+
+#endif // SRC_RENDER_TERMINAL_RENDERER_HPP
@@ -0,0 +1,51 @@
+#ifndef SRC_RENDER_TRIPLE_BUFFER_HPP
+#define SRC_RENDER_TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+
+#include <SDL3/SDL_stdinc.h>
+
+// Lock-free hand-off of the latest value from one writer thread to one reader
+// thread. The writer fills get_write_buffer() and publish()es it; the reader
+// calls update() and then reads get_read_buffer(), which the writer does not
+// touch until the reader's next update(). Neither side ever waits: values
+// published in between two update() calls are skipped, not queued.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // Writer thread only.
+    T &get_write_buffer() { return buffers[writeIndex]; }
+    void publish()
+    {
+        const Uint8 previous = middle.exchange(static_cast<Uint8>(writeIndex | FRESH_BIT), std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Reader thread only; true if a value was published since the last call.
+    bool update()
+    {
+        if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0U)
+            return false;
+        const Uint8 previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+    const T &get_read_buffer() const { return buffers[readIndex]; }
+
+private:
+    static constexpr Uint8 INDEX_MASK = 0b011U;
+    static constexpr Uint8 FRESH_BIT = 0b100U; // set by publish(), cleared by update()
+
+    std::array<T, 3> buffers{};
+    alignas(64) std::atomic<Uint8> middle{1U}; // index of the buffer between writer and reader
+    alignas(64) Uint8 writeIndex = 0U;
+    alignas(64) Uint8 readIndex = 2U;
+}; // class TripleBuffer
+
+#endif // SRC_RENDER_TRIPLE_BUFFER_HPP
@@ -3,13 +3,16 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 
 #include <SDL3/SDL_assert.h>
 #include <SDL3/SDL_log.h>
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_timer.h>
 #include <entt/entt.hpp>
 #include <sigslot/signal.hpp>
 
+#include <component/position.hpp>
 #include <component/velocity.hpp>
 #include <component/key_control.hpp>
 #include <component/snake_apple.hpp>
@@ -17,6 +20,9 @@
 #include <component/snake_part_head.hpp>
 #include <component/snake_boundary_2d.hpp>
 
+#include <profiler/tick_profiler.hpp>
+#include <profiler/trace_recorder.hpp>
+
 namespace SnakeGameplaySystem
 {
     enum MapSlotState : Uint8
@@ -25,11 +31,149 @@ namespace SnakeGameplaySystem
         SNAKE_HEAD = 0b0001U,
         SNAKE_BODY = 0b0010U,
         APPLE = 0b0100U,
+        OBSTACLE = 0b1000U,
 
         ENUM_END = 0b1111U,
     }; // enum MapSlotState
 
-    inline std::vector<std::vector<MapSlotState>> previousMap;
+    using Map = std::vector<std::vector<MapSlotState>>; // [i][j], row 0 is the top row
+
+    // What the system remembers between ticks. It lives in reg.ctx(), so every registry
+    // (a scene, a SnakeEnvironment, a snake_game handle) keeps its own copy and registries
+    // stepped alternately or on different threads never see each other's game.
+    struct State
+    {
+        bool hasOwnRandom = false; // see seed(); otherwise the process-wide SDL generator
+        Uint64 randomState = 0U;
+    }; // struct State
+
+    // Scratch buffers of one registry, in reg.ctx() next to State and sized by reserve(), so
+    // ticks reuse them without reaching the heap and never share them with another registry.
+    struct Scratch
+    {
+        Map map;
+        std::vector<long> cells;             // slots, y * x + x
+        std::vector<entt::entity> entities;  // one per cell, see Detail::index_board()
+    }; // struct Scratch
+
+    // Apple entity on each cell, y * x + x with row 0 at the top like get_map(), entt::null
+    // where there is none. Lives in reg.ctx(): init() builds it from the SnakeApple entities
+    // (or the first tick does, for a registry that skipped init() or was cleared and
+    // repopulated since) and Detail::apple_update() keeps it in step with the respawns, so
+    // finding the apple under the head is a single lookup however many apples the board holds.
+    struct AppleIndex
+    {
+        std::vector<entt::entity> cells;
+        entt::entity scene = entt::null; // SnakeBoundary2D entity of the scene it was built for
+    }; // struct AppleIndex
+
+    // Cells holding no part, head, apple or obstacle, y * x + x like AppleIndex and built with
+    // it: a dense list to draw a cell from in O(1) plus each cell's slot in that list, so a
+    // cell is taken in O(1) by moving the last one into its slot. Detail::do_trailing() and
+    // Detail::apple_update() keep it in step, so a respawn never scans the board.
+    struct FreeCells
+    {
+        std::vector<long> cells;   // in no particular order
+        std::vector<Sint32> slots; // index in cells, -1 on a cell that is not free
+
+        bool contains(const long &cell) const { return slots[cell] >= 0; }
+        void insert(const long &cell)
+        {
+            SDL_assert(!contains(cell));
+            slots[cell] = static_cast<Sint32>(cells.size());
+            cells.push_back(cell);
+        }
+        void erase(const long &cell)
+        {
+            SDL_assert(contains(cell));
+            const long last = cells.back();
+            cells[slots[cell]] = last;
+            slots[last] = slots[cell];
+            cells.pop_back();
+            slots[cell] = -1;
+        }
+    }; // struct FreeCells
+
+    // Walls and obstacles of a level, y * x + x like AppleIndex. load_obstacles() builds it
+    // once per level into reg.ctx(), which reg.clear() keeps, so restarts reuse it. A blocked
+    // cell kills the head like the boundary does and never receives an apple; every check is
+    // one bit test, and the unblocked cells seed FreeCells.
+    struct ObstacleLayer
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<Uint64> bits;    // bit (cell & 63) of bits[cell >> 6] is set on a blocked cell
+        std::vector<long> freeCells; // every cell that is not blocked, ascending
+
+        bool is_blocked(const long &cell) const { return (bits[cell >> 6] >> (cell & 63) & 1U) != 0U; }
+    }; // struct ObstacleLayer
+
+    // One snake of the scene: its head and a ring of its parts from the neck to the tail, so a
+    // move pushes the new neck and drops the tail in O(1) however long the snake is.
+    struct Snake
+    {
+        entt::entity head = entt::null;
+        long headCell = -1L;         // y * x + x the head is on in Snakes::heads, -1 off the board
+        long previousHeadCell = -1L; // the head's cell at the end of the last tick
+        bool isHeadOnHead = false;   // another head entered its cell
+        bool isCrashed = false;      // scratch of Detail::remove_crashed_snakes()
+        std::vector<entt::entity> ring; // ring[neck] onwards, length parts wrapping around
+        size_t neck = 0U;
+        size_t length = 0U;
+
+        entt::entity get_neck() const { return length != 0U ? ring[neck] : entt::null; }
+        entt::entity get_tail() const { return length != 0U ? ring[(neck + length - 1U) % ring.size()] : entt::null; }
+        void push_neck(const entt::entity &part)
+        {
+            grow();
+            neck = (neck + ring.size() - 1U) % ring.size();
+            ring[neck] = part;
+            length++;
+        }
+        void push_tail(const entt::entity &part)
+        {
+            grow();
+            ring[(neck + length) % ring.size()] = part;
+            length++;
+        }
+        void pop_tail()
+        {
+            SDL_assert(length != 0U);
+            length--;
+        }
+        void grow()
+        { // only past the room SnakeGameplaySystem::reserve() gave the ring
+            if (length < ring.size())
+                return;
+            std::vector<entt::entity> grown(ring.size() < 4U ? 4U : 2U * ring.size(), entt::null);
+            for (size_t k = 0; k < length; k++)
+                grown[k] = ring[(neck + k) % ring.size()];
+            ring.swap(grown);
+            neck = 0U;
+        }
+    }; // struct Snake
+
+    // Every snake of the scene and the cells the heads and the parts of all of them are on,
+    // y * x + x like AppleIndex and built with it. Sharing the two cell indices makes a head
+    // running into a body, its own or another one, or into another head a single lookup, so a
+    // tick costs O(number of snakes) instead of a scan of the board or of every part.
+    struct Snakes
+    {
+        std::vector<Snake> snakes;       // the first count are the scene's, the rest keep their rings for reuse
+        size_t count = 0U;
+        std::vector<entt::entity> parts; // part on each cell, entt::null where there is none
+        std::vector<entt::entity> heads; // head on each cell
+
+        Snake *find(const entt::entity &head)
+        {
+            for (size_t k = 0; k < count; k++)
+            {
+                if (snakes[k].head == head)
+                    return &snakes[k];
+            }
+            return nullptr;
+        }
+    }; // struct Snakes
 
     namespace Control
     {
@@ -39,6 +183,12 @@ namespace SnakeGameplaySystem
         static void left_key_down(entt::registry &reg);
         static void down_key_down(entt::registry &reg);
         static void right_key_down(entt::registry &reg);
+        static void shift_key_up(entt::registry &reg, const entt::entity &snakeHead);
+        static void shift_key_down(entt::registry &reg, const entt::entity &snakeHead);
+        static void up_key_down(entt::registry &reg, const entt::entity &snakeHead);
+        static void left_key_down(entt::registry &reg, const entt::entity &snakeHead);
+        static void down_key_down(entt::registry &reg, const entt::entity &snakeHead);
+        static void right_key_down(entt::registry &reg, const entt::entity &snakeHead);
     } // namespace Control
 
     namespace Util
@@ -49,94 +199,84 @@ namespace SnakeGameplaySystem
 
     namespace Detail
     {
-        static bool is_going_backwards(entt::registry &reg, const char &directionToGo);
-        static void do_trailing(entt::registry &reg, const bool &isAteApple);
+        static bool is_going_backwards(entt::registry &reg, const Snake &snake, const char &directionToGo);
+        static void steer(entt::registry &reg, const Snake &snake, const KeyControl &keyControl);
+        static void do_trailing(entt::registry &reg, Snake &snake, const bool &isAteApple);
         static bool apple_update(entt::registry &reg);
+        static bool is_crashed(entt::registry &reg, Snakes &snakes, const Snake &snake, const SnakeBoundary2D &boundary);
+        static void remove_crashed_snakes(entt::registry &reg);
+        static void remove_snake(entt::registry &reg, Snakes &snakes, const size_t &k, const SnakeBoundary2D &boundary);
+        static void release_cell(entt::registry &reg, const SnakeBoundary2D &boundary, const long &cell);
+        static void index_board(entt::registry &reg);
+        static void sync_heads(entt::registry &reg, Snakes &snakes, const SnakeBoundary2D &boundary);
+        static AppleIndex &get_apple_index(entt::registry &reg, const SnakeBoundary2D &boundary);
+        static FreeCells &get_free_cells(entt::registry &reg, const SnakeBoundary2D &boundary);
+        static Snakes &get_snakes(entt::registry &reg, const SnakeBoundary2D &boundary);
+        static KeyControl &get_key_control(entt::registry &reg, const entt::entity &snakeHead);
+        static State &get_state(entt::registry &reg);
+        static Scratch &get_scratch(entt::registry &reg);
+        static long get_cell(const Position &pos, const SnakeBoundary2D &boundary);
+        static long get_next_cell(const Position &pos, const char &direction, const SnakeBoundary2D &boundary);
+        static Sint32 draw(entt::registry &reg, const Sint32 &n);
     } // namespace Detail
 
     static std::vector<std::vector<MapSlotState>> get_map(entt::registry &reg);
+    static void get_map(entt::registry &reg, Map &map);
+    static void get_board(const entt::registry &reg, Uint8 *board);
     static bool is_game_success(entt::registry &reg);
     static bool is_game_failure(entt::registry &reg);
+    static bool is_snake_failure(entt::registry &reg, const entt::entity &snakeHead);
     static unsigned long get_score(entt::registry &reg);
+    static unsigned long get_score(entt::registry &reg, const entt::entity &snakeHead);
     static bool is_speeding_up(entt::registry &reg);
+    static bool parse_level(const char *text, const size_t &length, const SnakeBoundary2D &boundary, std::vector<Uint8> &mask);
+    static void load_obstacles(entt::registry &reg, const SnakeBoundary2D &boundary, const Uint8 *mask);
+    static const ObstacleLayer *find_obstacles(const entt::registry &reg);
+    static long find_open_cell(const entt::registry &reg, const SnakeBoundary2D &boundary, const long &cell,
+                               const long *takenCells = nullptr, const size_t &takenCount = 0U);
+    static void seed(entt::registry &reg, const Uint64 &seed);
 
+    // Runs every snake of the scene, one per SnakePartHead. A snake steers by the KeyControl
+    // on its head, or the scene's one (on the SnakeBoundary2D entity) when its head has none.
+    // A crashed snake is taken off the board with its body while another one still runs; the
+    // game is over once every snake has crashed (see is_game_failure()).
     static void iterate(entt::registry &reg)
     {
+        SNAKE_PROFILE_SCOPE(TickProfiler::GAMEPLAY);
+        SNAKE_TRACE_SCOPE("SnakeGameplaySystem::iterate");
         if (is_game_success(reg))
             return;
         if (is_game_failure(reg))
             return;
 
-        const bool ateApple = Detail::apple_update(reg);
-
-        auto keyControlView = reg.view<KeyControl>();
-        SDL_assert(keyControlView.size() == 1);
-        KeyControl keyControl = reg.get<KeyControl>(keyControlView.front());
+        Detail::remove_crashed_snakes(reg);
+        Detail::apple_update(reg);
 
-        auto snakeHeadView = reg.view<Velocity, SnakePartHead>();
-        SDL_assert(snakeHeadView.storage<SnakePartHead>()->size() == 1);
-        for (auto &entity : snakeHeadView)
+        const entt::entity scene = reg.view<SnakeBoundary2D>().front();
+        const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(scene);
+        const KeyControl *sceneKeyControl = reg.try_get<KeyControl>(scene);
+        Snakes &snakes = Detail::get_snakes(reg, boundary);
+        for (size_t k = 0; k < snakes.count; k++)
         {
-            Velocity &vel = snakeHeadView.get<Velocity>(entity);
-            SnakePartHead &headPart = snakeHeadView.get<SnakePartHead>(entity);
-            switch (keyControl.lastMovementKeyDown)
-            {
-            case 'w':
-                if (Detail::is_going_backwards(reg, 'w'))
-                    break;
-                vel.x = 0.0f;
-                vel.y = headPart.speed;
-                if (keyControl.isShiftKeyDown)
-                    vel.y *= headPart.speedUpFactor;
-                break;
-            case 'a':
-                if (Detail::is_going_backwards(reg, 'a'))
-                    break;
-                vel.x = -1.0f * headPart.speed;
-                if (keyControl.isShiftKeyDown)
-                    vel.x *= headPart.speedUpFactor;
-                vel.y = 0.0f;
-                break;
-            case 's':
-                if (Detail::is_going_backwards(reg, 's'))
-                    break;
-                vel.x = 0.0f;
-                vel.y = -1.0f * headPart.speed;
-                if (keyControl.isShiftKeyDown)
-                    vel.y *= headPart.speedUpFactor;
-                break;
-            case 'd':
-                if (Detail::is_going_backwards(reg, 'd'))
-                    break;
-                vel.x = headPart.speed;
-                if (keyControl.isShiftKeyDown)
-                    vel.x *= headPart.speedUpFactor;
-                vel.y = 0.0f;
-                break;
-            default:
-                break;
-            }
+            const Snake &snake = snakes.snakes[k];
+            const KeyControl *keyControl = reg.try_get<KeyControl>(snake.head);
+            if (keyControl == nullptr)
+                keyControl = sceneKeyControl;
+            if (keyControl != nullptr && reg.all_of<Velocity>(snake.head))
+                Detail::steer(reg, snake, *keyControl);
         }
-        previousMap = get_map(reg);
 
-        const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front());
-        for (int i = 0; i < previousMap.size(); i++)
+        for (size_t k = 0; k < snakes.count; k++)
         {
-            for (int j = 0; j < previousMap[i].size(); j++)
-            {
-                if ((previousMap[i][j] & MapSlotState::SNAKE_HEAD) && (previousMap[i][j] & MapSlotState::SNAKE_BODY))
-                {
-                    auto snakePartView = reg.view<SnakePart>();
-                    for (auto &entity : snakePartView)
-                    {
-                        const Position pos = reg.get<Position>(entity);
-                        long xIndex, yIndex;
-                        Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                        if (xIndex == j && yIndex == i)
-                            reg.destroy(entity);
-                    }
-                }
-            }
+            Snake &snake = snakes.snakes[k];
+            snake.previousHeadCell = snake.headCell;
+            if (snake.headCell < 0 || snakes.parts[snake.headCell] == entt::null || snakes.parts[snake.headCell] != snake.get_tail())
+                continue;
+            // the tail the head just caught up with
+            const entt::entity tail = snake.get_tail();
+            snake.pop_tail();
+            snakes.parts[snake.headCell] = entt::null;
+            reg.destroy(tail);
         }
     }
     static void update(entt::registry &reg) { return iterate(reg); }
@@ -148,9 +288,55 @@ namespace SnakeGameplaySystem
             if (snakeHeadView.empty())
                 return false;
         }
-        previousMap = get_map(reg);
+        if (const ObstacleLayer *obstacles = find_obstacles(reg))
+        {
+            const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front());
+            SDL_assert(obstacles->width == boundary.x && obstacles->height == boundary.y); // reload per level
+        }
+        Detail::index_board(reg);
         return true;
     }
+    // Grows every pool the game uses to a full board of parts and of apples, for snakeCount
+    // snakes. reg.clear() keeps pool capacity, so a restart that re-creates the scene in the
+    // same registry then only resets sizes: neither the game nor the restart reaches the heap.
+    static void reserve(entt::registry &reg, const SnakeBoundary2D &boundary, const size_t &snakeCount = 1U)
+    {
+        SDL_assert(boundary.x >= 1 && boundary.y >= 1 && snakeCount >= 1U);
+        const size_t cellCount = static_cast<size_t>(boundary.x) * static_cast<size_t>(boundary.y);
+        reg.storage<entt::entity>().reserve(2U * cellCount + 1U); // parts, heads, apples and game state
+        reg.storage<Position>().reserve(2U * cellCount);          // parts, heads and apples
+        reg.storage<SnakePart>().reserve(cellCount);
+        reg.storage<SnakePartHead>().reserve(snakeCount);
+        reg.storage<Velocity>().reserve(snakeCount);
+        reg.storage<KeyControl>().reserve(snakeCount + 1U); // the scene's and one per head
+        reg.storage<SnakeApple>().reserve(cellCount); // any number of apples, one per cell at most
+        AppleIndex &appleIndex = reg.ctx().emplace<AppleIndex>();
+        appleIndex.cells.reserve(cellCount);
+        appleIndex.scene = entt::null; // a new scene follows, so the next init() or tick rebuilds
+        FreeCells &freeCells = reg.ctx().emplace<FreeCells>();
+        freeCells.cells.reserve(cellCount);
+        freeCells.slots.reserve(cellCount);
+        Snakes &snakes = reg.ctx().emplace<Snakes>();
+        if (snakes.snakes.size() < snakeCount)
+            snakes.snakes.resize(snakeCount);
+        for (size_t k = 0; k < snakeCount; k++)
+        { // the board shared out evenly; a longer snake doubles its ring
+            Snake &snake = snakes.snakes[k];
+            snake.neck = 0U;
+            snake.length = 0U;
+            if (snake.ring.size() < cellCount / snakeCount)
+                snake.ring.assign(cellCount / snakeCount, entt::null);
+        }
+        snakes.parts.reserve(cellCount);
+        snakes.heads.reserve(cellCount);
+        Detail::get_state(reg); // made here rather than by the first respawn
+        Scratch &scratch = Detail::get_scratch(reg);
+        scratch.map.resize(static_cast<size_t>(boundary.y));
+        for (auto &row : scratch.map)
+            row.reserve(static_cast<size_t>(boundary.x));
+        scratch.cells.reserve(cellCount);
+        scratch.entities.reserve(cellCount);
+    }
     static bool init(sigslot::signal<entt::registry &> &signal, entt::registry &reg)
     {
         static std::list<sigslot::signal<entt::registry &> *> regSignalArray;
@@ -174,6 +360,14 @@ namespace SnakeGameplaySystem
 
     static std::vector<std::vector<MapSlotState>> get_map(entt::registry &reg)
     {
+        Map ret;
+        get_map(reg, ret);
+        return ret;
+    }
+    // Fills map in place; reusing the same map for a board size never allocates.
+    static void get_map(entt::registry &reg, Map &ret)
+    {
+        SNAKE_PROFILE_SCOPE(TickProfiler::GET_MAP);
         auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
         SDL_assert(snakeBoundaryView.size() == 1);
         const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
@@ -181,7 +375,17 @@ namespace SnakeGameplaySystem
         const int xSize = boundary.x;
         const int ySize = boundary.y;
 
-        std::vector<std::vector<MapSlotState>> ret(ySize, std::vector<MapSlotState>(xSize, MapSlotState::EMPTY));
+        ret.resize(ySize);
+        for (auto &row : ret)
+            row.assign(xSize, MapSlotState::EMPTY);
+        if (const ObstacleLayer *obstacles = find_obstacles(reg))
+        {
+            for (long cell = 0; cell < static_cast<long>(xSize) * ySize; cell++)
+            {
+                if (obstacles->is_blocked(cell))
+                    ret[cell / xSize][cell % xSize] = MapSlotState::OBSTACLE;
+            }
+        }
 
         auto snakePartView = reg.view<SnakePart, Position>();
         for (auto &entity : snakePartView)
@@ -218,12 +422,66 @@ namespace SnakeGameplaySystem
                 ret[yIndex][xIndex] = static_cast<MapSlotState>(entry);
             }
         }
+    }
+    // Flat form of get_map(): SnakeBoundary2D y * x bytes, row 0 is the top row, every
+    // state of a slot ORed together. board MUST hold at least that many bytes.
+    static void get_board(const entt::registry &reg, Uint8 *board)
+    {
+        SDL_assert(board != nullptr);
+        auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
+        SDL_assert(snakeBoundaryView.size() == 1);
+        const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
+        SDL_memset(board, MapSlotState::EMPTY, static_cast<size_t>(boundary.x) * static_cast<size_t>(boundary.y));
+        if (const ObstacleLayer *obstacles = find_obstacles(reg))
+        {
+            for (long cell = 0; cell < static_cast<long>(boundary.x) * boundary.y; cell++)
+            {
+                if (obstacles->is_blocked(cell))
+                    board[cell] = MapSlotState::OBSTACLE;
+            }
+        }
 
-        return ret;
+        auto mark = [&](const Uint8 &state, const Position &pos)
+        {
+            long x, y;
+            SnakeGameplaySystem::Util::get_index_from_pos(pos, &x, &y, boundary.y);
+            if (x >= 0 && y >= 0 && x < boundary.x && y < boundary.y)
+                board[static_cast<size_t>(y) * boundary.x + static_cast<size_t>(x)] |= state;
+        };
+
+        auto snakePartView = reg.view<SnakePart, Position>();
+        for (auto &entity : snakePartView)
+            mark(MapSlotState::SNAKE_BODY, snakePartView.get<Position>(entity));
+        auto snakeHeadView = reg.view<SnakePartHead, Position>();
+        for (auto &entity : snakeHeadView)
+            mark(MapSlotState::SNAKE_HEAD, snakeHeadView.get<Position>(entity));
+        auto appleView = reg.view<SnakeApple, Position>();
+        for (auto &entity : appleView)
+            mark(MapSlotState::APPLE, appleView.get<Position>(entity));
     }
     static bool is_game_success(entt::registry &reg)
     {
-        auto map = get_map(reg);
+        SNAKE_PROFILE_SCOPE(TickProfiler::COLLISION_CHECK);
+        { // every reachable slot needs its own part or head, so a shorter snake has not won yet
+            const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front());
+            const ObstacleLayer *obstacles = find_obstacles(reg);
+            const size_t reachableCount = obstacles != nullptr ? obstacles->freeCells.size()
+                                                               : static_cast<size_t>(boundary.x) * static_cast<size_t>(boundary.y);
+            if (reg.view<SnakePart>().size() + reg.view<SnakePartHead>().size() < reachableCount)
+                return false;
+        }
+        Map &map = Detail::get_scratch(reg).map;
+        get_map(reg, map);
+        if (const ObstacleLayer *obstacles = find_obstacles(reg))
+        { // only the cells a snake can reach have to be filled
+            for (const long &cell : obstacles->freeCells)
+            {
+                const MapSlotState state = map[cell / obstacles->width][cell % obstacles->width];
+                if (state == MapSlotState::EMPTY || state == MapSlotState::APPLE)
+                    return false;
+            }
+            return true;
+        }
         for (int i = 0; i < map.size(); i++)
         {
             for (int j = 0; j < map[i].size(); j++)
@@ -234,218 +492,254 @@ namespace SnakeGameplaySystem
         }
         return true;
     }
+    // True once every snake has crashed, see is_snake_failure().
     static bool is_game_failure(entt::registry &reg)
     {
-        auto snakeHeadPos = reg.get<Position>(reg.view<SnakePartHead, Position>().front());
-        auto boundary = reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front());
-        if (snakeHeadPos.x < 0.0f || snakeHeadPos.x >= boundary.x || snakeHeadPos.y < 0.0f || snakeHeadPos.y >= boundary.y)
+        SNAKE_PROFILE_SCOPE(TickProfiler::COLLISION_CHECK);
+        const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front());
+        Snakes &snakes = Detail::get_snakes(reg, boundary);
+        for (size_t k = 0; k < snakes.count; k++)
+        {
+            if (!Detail::is_crashed(reg, snakes, snakes.snakes[k], boundary))
+                return false;
+        }
+        return true;
+    }
+    // Whether the snake of snakeHead left the board, hit an obstacle, a body or another head,
+    // or was already taken off the board for it.
+    static bool is_snake_failure(entt::registry &reg, const entt::entity &snakeHead)
+    {
+        if (!reg.valid(snakeHead) || !reg.all_of<SnakePartHead>(snakeHead))
             return true;
-
-        auto map = get_map(reg);
-        for (int i = 0; i < map.size(); i++)
+        const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front());
+        Snakes &snakes = Detail::get_snakes(reg, boundary);
+        const Snake *snake = snakes.find(snakeHead);
+        return snake == nullptr || Detail::is_crashed(reg, snakes, *snake, boundary);
+    }
+    static unsigned long get_score(entt::registry &reg) { return reg.view<SnakePart>().size(); }
+    // Length of the body of snakeHead's snake, 0 once it is off the board.
+    static unsigned long get_score(entt::registry &reg, const entt::entity &snakeHead)
+    {
+        if (!reg.valid(snakeHead) || !reg.all_of<SnakePartHead>(snakeHead))
+            return 0UL;
+        const Snake *snake = Detail::get_snakes(reg, reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front())).find(snakeHead);
+        return snake != nullptr ? static_cast<unsigned long>(snake->length) : 0UL;
+    }
+    static bool is_speeding_up(entt::registry &reg) { return reg.get<KeyControl>(reg.view<SnakeBoundary2D>().front()).isShiftKeyDown; }
+    // Reads a level drawn as text into a mask for load_obstacles(): one line per row from the
+    // top, '#' for a blocked cell and any other character for an open one. Rows and columns
+    // the text leaves out are open. False if the text is wider or taller than the board, or
+    // leaves fewer than two cells open, one for the head and one for an apple.
+    static bool parse_level(const char *text, const size_t &length, const SnakeBoundary2D &boundary, std::vector<Uint8> &mask)
+    {
+        SDL_assert(text != nullptr || length == 0U);
+        mask.assign(static_cast<size_t>(boundary.x) * static_cast<size_t>(boundary.y), 0U);
+        long x = 0, y = 0;
+        for (size_t k = 0; k < length; k++)
         {
-            for (int j = 0; j < map[i].size(); j++)
+            if (text[k] == '\n')
             {
-                if ((static_cast<Uint8>(map[i][j]) & SNAKE_HEAD) && (static_cast<Uint8>(map[i][j]) & SNAKE_BODY))
-                { // TODO: refactor below and also the same code to find tail in Detail::do_trailing()
-                    auto snakePartView = reg.view<Position, SnakePart>();
-                    struct Index
-                    {
-                        explicit Index(const int &_i, const int &_j) : i(_i), j(_j) {}
-                        int i;
-                        int j;
-                    }; // struct Index
-                    std::vector<Index> indexVec;
-                    for (const auto &entity : snakePartView)
-                    {
-                        const bool isValid = reg.all_of<SnakePart, Position>(entity);
-                        SDL_assert(isValid);
-                        Position pos = reg.get<Position>(entity);
-                        const SnakePart snakePart = reg.get<SnakePart>(entity);
-                        switch (snakePart.currentDirection)
-                        {
-                        case 'w':
-                        {
-                            pos.y += 1.0f;
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex >= 0 && xIndex < boundary.x && yIndex >= 0 && yIndex < boundary.y)
-                                indexVec.push_back(Index(yIndex, xIndex));
-                            break;
-                        }
-                        case 'a':
-                        {
-                            pos.x -= 1.0f;
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex >= 0 && xIndex < boundary.x && yIndex >= 0 && yIndex < boundary.y)
-                                indexVec.push_back(Index(yIndex, xIndex));
-                            break;
-                        }
-                        case 's':
-                        {
-                            pos.y -= 1.0f;
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex >= 0 && xIndex < boundary.x && yIndex >= 0 && yIndex < boundary.y)
-                                indexVec.push_back(Index(yIndex, xIndex));
-                            break;
-                        }
-                        case 'd':
-                        {
-                            pos.x += 1.0f;
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex >= 0 && xIndex < boundary.x && yIndex >= 0 && yIndex < boundary.y)
-                                indexVec.push_back(Index(yIndex, xIndex));
-                            break;
-                        }
-                        }
-                    }
-                    // Now that the pool of indices of next parts are gotten,
-                    // look for the 1 part that doesn't have index within the pool.
-                    bool hasFoundTail = false;
-                    for (auto &entity : snakePartView)
-                    {
-                        const Position pos = reg.get<Position>(entity);
-                        long xIndex, yIndex;
-                        Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                        bool isInPool = false;
-                        for (Index index : indexVec)
-                        {
-                            if (index.i == yIndex && index.j == xIndex)
-                            {
-                                isInPool = true;
-                                break;
-                            }
-                        }
-                        if (!isInPool)
-                        {
-                            hasFoundTail = true;
-                            const Position tailPos = reg.get<Position>(entity);
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(tailPos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex == j && yIndex == i) // this means it's the tail
-                                return false;
-                            else
-                                return true;
-                        }
-                    }
-                    return true;
-                }
+                x = 0;
+                y++;
+                continue;
             }
+            if (text[k] == '\r')
+                continue;
+            if (x >= boundary.x || y >= boundary.y)
+                return false;
+            mask[static_cast<size_t>(y * boundary.x + x)] = text[k] == '#';
+            x++;
         }
-        return false;
+        size_t openCount = 0U;
+        for (const Uint8 &isBlocked : mask)
+            openCount += isBlocked == 0U;
+        return openCount >= 2U;
     }
-    static unsigned long get_score(entt::registry &reg) { return reg.view<SnakePart>().size(); }
-    static bool is_speeding_up(entt::registry &reg) { return reg.get<KeyControl>(reg.view<KeyControl>().front()).isShiftKeyDown; }
-
-    namespace Detail
+    // mask holds boundary.y * boundary.x bytes, row 0 is the top row, non-zero where a cell
+    // is blocked; nullptr clears the layer. Call once per level, before init().
+    static void load_obstacles(entt::registry &reg, const SnakeBoundary2D &boundary, const Uint8 *mask)
     {
-        static bool is_going_backwards(entt::registry &reg, const char &directionToGo)
+        SDL_assert(boundary.x >= 1 && boundary.y >= 1);
+        ObstacleLayer &obstacles = reg.ctx().emplace<ObstacleLayer>();
+        if (mask == nullptr)
         {
-            struct Index
+            obstacles = ObstacleLayer{};
+            return;
+        }
+        const long cellCount = static_cast<long>(boundary.x) * boundary.y;
+        obstacles.width = boundary.x;
+        obstacles.height = boundary.y;
+        obstacles.bits.assign(static_cast<size_t>((cellCount + 63) >> 6), 0U);
+        obstacles.freeCells.clear();
+        for (long cell = 0; cell < cellCount; cell++)
+        {
+            if (mask[cell] != 0U)
+                obstacles.bits[cell >> 6] |= Uint64{1U} << (cell & 63);
+            else
+                obstacles.freeCells.push_back(cell);
+        }
+    }
+    // Gives reg its own apple placement stream, splitmix64 of seed like
+    // SnakeBatchEnvironment::reset(); seed 0 picks a time-based seed.
+    static void seed(entt::registry &reg, const Uint64 &seed)
+    {
+        Uint64 z = (seed != 0U ? seed : SDL_GetPerformanceCounter()) + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        State &state = Detail::get_state(reg);
+        state.randomState = z ^ (z >> 31);
+        state.hasOwnRandom = true;
+    }
+    // nullptr on an open board.
+    static const ObstacleLayer *find_obstacles(const entt::registry &reg)
+    {
+        const ObstacleLayer *obstacles = reg.ctx().find<ObstacleLayer>();
+        return (obstacles != nullptr && !obstacles->bits.empty()) ? obstacles : nullptr;
+    }
+    // Where to put a head or an apple that should go on cell, y * x + x: cell itself when it is
+    // open and not one of the takenCount takenCells, else the nearest such cell of the level;
+    // -1 if there is none. Scans the open cells, so it is meant for setting up a scene, not for
+    // a tick.
+    static long find_open_cell(const entt::registry &reg, const SnakeBoundary2D &boundary, const long &cell,
+                               const long *takenCells, const size_t &takenCount)
+    {
+        SDL_assert(takenCells != nullptr || takenCount == 0U);
+        auto isTaken = [&](const long &candidate)
+        {
+            for (size_t k = 0; k < takenCount; k++)
             {
-                explicit Index(const int &_i, const int &_j) : i(_i), j(_j) {}
-                int i;
-                int j;
-                bool isInvalid() { return i < 0 || j < 0; }
-            };
-            auto map = get_map(reg);
-            Index indexOfSnakeHead(-1, -1);
-            for (int i = 0; i < map.size(); i++)
+                if (takenCells[k] == candidate)
+                    return true;
+            }
+            return false;
+        };
+        const long cellCount = static_cast<long>(boundary.x) * boundary.y;
+        const ObstacleLayer *obstacles = find_obstacles(reg);
+        if ((obstacles == nullptr || !obstacles->is_blocked(cell)) && !isTaken(cell))
+            return cell;
+        long ret = -1L, retDistance = 0L;
+        auto consider = [&](const long &openCell)
+        {
+            const long distance = SDL_abs(static_cast<int>(openCell / boundary.x - cell / boundary.x)) +
+                                  SDL_abs(static_cast<int>(openCell % boundary.x - cell % boundary.x));
+            if (!isTaken(openCell) && (ret < 0 || distance < retDistance))
             {
-                for (int j = 0; j < map[i].size(); j++)
-                {
-                    if (map[i][j] == MapSlotState::SNAKE_HEAD)
-                        indexOfSnakeHead = Index(i, j);
-                }
+                ret = openCell;
+                retDistance = distance;
             }
-            if (indexOfSnakeHead.isInvalid())
+        };
+        if (obstacles != nullptr)
+        {
+            for (const long &openCell : obstacles->freeCells)
+                consider(openCell);
+        }
+        else
+        {
+            for (long openCell = 0; openCell < cellCount; openCell++)
+                consider(openCell);
+        }
+        return ret;
+    }
+
+    namespace Detail
+    {
+        static bool is_going_backwards(entt::registry &reg, const Snake &snake, const char &directionToGo)
+        {
+            auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
+            SDL_assert(snakeBoundaryView.size() == 1);
+            const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
+            const long headCell = snake.headCell;
+            if (headCell < 0)
                 return true;
+            if (get_apple_index(reg, boundary).cells[headCell] != entt::null)
+                return true; // the head is not alone on its slot
+            const Snakes &snakes = get_snakes(reg, boundary);
+            if (snakes.parts[headCell] != entt::null)
+                return true; // the head is not alone on its slot
 
-            int i = indexOfSnakeHead.i, j = indexOfSnakeHead.j;
+            // The part on the slot in directionToGo is the "neck" if it moves towards the head.
+            long i = headCell / boundary.x, j = headCell % boundary.x;
+            char towardsHead;
             switch (directionToGo)
-            { // check if it's a wall or not a snake body
+            {
             case 'w':
-                if (i == 0)
-                    return false;
-                if (map[i - 1][j] != MapSlotState::SNAKE_BODY)
-                    return false;
+                i--;
+                towardsHead = 's';
                 break;
             case 'a':
-                if (j == 0)
-                    return false;
-                if (map[i][j - 1] != MapSlotState::SNAKE_BODY)
-                    return false;
+                j--;
+                towardsHead = 'd';
                 break;
             case 's':
-                if (i == map.size() - 1)
-                    return false;
-                if (map[i + 1][j] != MapSlotState::SNAKE_BODY)
-                    return false;
+                i++;
+                towardsHead = 'w';
                 break;
             case 'd':
-                if (j == map[i].size() - 1)
-                    return false;
-                if (map[i][j + 1] != MapSlotState::SNAKE_BODY)
-                    return false;
+                j++;
+                towardsHead = 'a';
                 break;
             default:
+                SDL_assert(directionToGo == 'w' || directionToGo == 'a' || directionToGo == 's' || directionToGo == 'd');
                 return true;
             }
+            if (i < 0 || j < 0 || i >= boundary.y || j >= boundary.x)
+                return false; // a wall, not a snake body
 
-            // It's a snake body at the directionToGo. Find out if it's
-            // the "neck". If it's not, return false.
-            auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
-            SDL_assert(snakeBoundaryView.size() == 1);
-            const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
-
-            auto view = reg.view<Position, SnakePart>();
-            for (auto &entity : view)
+            const entt::entity part = snakes.parts[i * boundary.x + j];
+            return part != entt::null && reg.get<SnakePart>(part).currentDirection == towardsHead;
+        }
+        // Turns the snake's head the way keyControl asks, unless that is back into its neck.
+        static void steer(entt::registry &reg, const Snake &snake, const KeyControl &keyControl)
+        {
+            Velocity &vel = reg.get<Velocity>(snake.head);
+            const SnakePartHead &headPart = reg.get<SnakePartHead>(snake.head);
+            switch (keyControl.lastMovementKeyDown)
             {
-                const Position &pos = reg.get<Position>(entity);
-                long xIndex, yIndex;
-                Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                switch (directionToGo)
-                {
-                // Get the body part in that direction and get its currentDirection.
-                // If the currentDirection is opposite of directionToGo, return true.
-                case 'w':
-                {
-                    if (xIndex == j && yIndex == i - 1 && reg.get<SnakePart>(entity).currentDirection == 's')
-                        return true;
+            case 'w':
+                if (is_going_backwards(reg, snake, 'w'))
                     break;
-                }
-                case 'a':
-                {
-                    if (xIndex == j - 1 && yIndex == i && reg.get<SnakePart>(entity).currentDirection == 'd')
-                        return true;
+                vel.x = 0.0f;
+                vel.y = headPart.speed;
+                if (keyControl.isShiftKeyDown)
+                    vel.y *= headPart.speedUpFactor;
+                break;
+            case 'a':
+                if (is_going_backwards(reg, snake, 'a'))
                     break;
-                }
-                case 's':
-                {
-                    if (xIndex == j && yIndex == i + 1 && reg.get<SnakePart>(entity).currentDirection == 'w')
-                        return true;
+                vel.x = -1.0f * headPart.speed;
+                if (keyControl.isShiftKeyDown)
+                    vel.x *= headPart.speedUpFactor;
+                vel.y = 0.0f;
+                break;
+            case 's':
+                if (is_going_backwards(reg, snake, 's'))
                     break;
-                }
-                case 'd':
-                {
-                    if (xIndex == j + 1 && yIndex == i && reg.get<SnakePart>(entity).currentDirection == 'a')
-                        return true;
+                vel.x = 0.0f;
+                vel.y = -1.0f * headPart.speed;
+                if (keyControl.isShiftKeyDown)
+                    vel.y *= headPart.speedUpFactor;
+                break;
+            case 'd':
+                if (is_going_backwards(reg, snake, 'd'))
                     break;
-                }
-                default:
-                    SDL_assert(directionToGo == 'w' || directionToGo == 'a' || directionToGo == 's' || directionToGo == 'd');
-                    return true;
-                }
+                vel.x = headPart.speed;
+                if (keyControl.isShiftKeyDown)
+                    vel.x *= headPart.speedUpFactor;
+                vel.y = 0.0f;
+                break;
+            default:
+                break;
             }
-            return false;
         }
-        static void do_trailing(entt::registry &reg, const bool &isAteApple)
+        static void do_trailing(entt::registry &reg, Snake &snake, const bool &isAteApple)
         { // NOTE: this function is the reason why the update loop NEEDS to limit DeltaTime
-            auto currentMap = get_map(reg);
-            if (currentMap == previousMap)
+            SNAKE_PROFILE_SCOPE(TickProfiler::DO_TRAILING);
+            auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
+            SDL_assert(snakeBoundaryView.size() == 1);
+            const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
+            const long previousHeadCell = snake.previousHeadCell;
+            const long currentHeadCell = snake.headCell;
+            if (previousHeadCell < 0 || currentHeadCell < 0 || previousHeadCell == currentHeadCell)
                 return;
 
             struct Index
@@ -455,25 +749,8 @@ namespace SnakeGameplaySystem
                 int j;
             }; // struct Index
 
-            auto getSnakeHeadIndices = [](const std::vector<std::vector<MapSlotState>> &map)
-            {
-                Index ret(-1, -1);
-                for (int i = 0; i < map.size(); i++)
-                {
-                    for (int j = 0; j < map[i].size(); j++)
-                    {
-                        if (map[i][j] & MapSlotState::SNAKE_HEAD)
-                            return Index(i, j);
-                    }
-                }
-                return ret;
-            };
-
-            Index previousSnakeHeadIndex = getSnakeHeadIndices(previousMap);
-            Index currentSnakeHeadIndex = getSnakeHeadIndices(currentMap);
-
-            if (previousSnakeHeadIndex.i == currentSnakeHeadIndex.i && previousSnakeHeadIndex.j == currentSnakeHeadIndex.j)
-                return;
+            const Index previousSnakeHeadIndex(previousHeadCell / boundary.x, previousHeadCell % boundary.x);
+            const Index currentSnakeHeadIndex(currentHeadCell / boundary.x, currentHeadCell % boundary.x);
 
             char travelledDirection = '\t';
             if (currentSnakeHeadIndex.i < previousSnakeHeadIndex.i)
@@ -489,289 +766,429 @@ namespace SnakeGameplaySystem
             if (travelledDirection == '\t')
                 return;
 
-            auto snakePartView = reg.view<SnakePart>();
-            if (snakePartView.empty())
-            {
-                if (!isAteApple)
-                    return;
-
-                // Ate apple, so spawn a part behind the snake head.
-                auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
-                SDL_assert(snakeBoundaryView.size() == 1);
-                const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
-                const int i = currentSnakeHeadIndex.i, j = currentSnakeHeadIndex.j;
-                switch (travelledDirection)
-                {
-                case 'w':
-                {
-                    auto entitySnakePart = reg.create();
-                    reg.emplace<SnakePart>(entitySnakePart, 'w');
-                    reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(j, i + 1, boundary.y));
-                    break;
-                }
-                case 'a':
-                {
-                    auto entitySnakePart = reg.create();
-                    reg.emplace<SnakePart>(entitySnakePart, 'a');
-                    reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(j + 1, i, boundary.y));
-                    break;
-                }
-                case 's':
-                {
-                    auto entitySnakePart = reg.create();
-                    reg.emplace<SnakePart>(entitySnakePart, 's');
-                    reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(j, i - 1, boundary.y));
-                    break;
-                }
-                case 'd':
-                {
-                    auto entitySnakePart = reg.create();
-                    reg.emplace<SnakePart>(entitySnakePart, 'd');
-                    reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(j - 1, i, boundary.y));
-                    break;
-                }
-                } // switch (travelledDirection)
+            Snakes &snakes = get_snakes(reg, boundary);
+            FreeCells &freeCells = get_free_cells(reg, boundary);
+            if (snake.length == 0U && !isAteApple)
+            { // a lone head leaves nothing behind
+                release_cell(reg, boundary, previousHeadCell);
+                return;
             }
-            else
+
+            // Spawn in the neck behind the head, facing the way the head went.
+            int i = currentSnakeHeadIndex.i, j = currentSnakeHeadIndex.j;
+            switch (travelledDirection)
             {
-                auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
-                SDL_assert(snakeBoundaryView.size() == 1);
-                const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
-                int i = currentSnakeHeadIndex.i, j = currentSnakeHeadIndex.j;
-                switch (travelledDirection)
-                { // spawn in neck part
-                case 'w':
-                {
-                    auto entitySnakePart = reg.create();
-                    reg.emplace<SnakePart>(entitySnakePart, 'w');
-                    reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(j, ++i, boundary.y));
-                    break;
-                }
-                case 'a':
-                {
-                    auto entitySnakePart = reg.create();
-                    reg.emplace<SnakePart>(entitySnakePart, 'a');
-                    reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(++j, i, boundary.y));
-                    break;
-                }
-                case 's':
-                {
-                    auto entitySnakePart = reg.create();
-                    reg.emplace<SnakePart>(entitySnakePart, 's');
-                    reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(j, --i, boundary.y));
-                    break;
-                }
-                case 'd':
-                {
-                    auto entitySnakePart = reg.create();
-                    reg.emplace<SnakePart>(entitySnakePart, 'd');
-                    reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(--j, i, boundary.y));
-                    break;
-                }
-                } // switch (travelledDirection)
+            case 'w':
+                i++;
+                break;
+            case 'a':
+                j++;
+                break;
+            case 's':
+                i--;
+                break;
+            case 'd':
+                j--;
+                break;
+            } // switch (travelledDirection)
+            auto entitySnakePart = reg.create();
+            reg.emplace<SnakePart>(entitySnakePart, travelledDirection);
+            reg.emplace<Position>(entitySnakePart, Util::get_pos_from_index(j, i, boundary.y));
+            const long neckCell = static_cast<long>(i) * boundary.x + j;
+            snake.push_neck(entitySnakePart);
+            snakes.parts[neckCell] = entitySnakePart;
+            if (freeCells.contains(neckCell))
+                freeCells.erase(neckCell);
+            if (neckCell != previousHeadCell)
+                release_cell(reg, boundary, previousHeadCell); // the head jumped a cell
+
+            if (isAteApple)
+                return;
+            // No apple, so the tail moves up: the last part of the ring goes.
+            const entt::entity tail = snake.get_tail();
+            snake.pop_tail();
+            const long tailCell = get_cell(reg.get<Position>(tail), boundary);
+            reg.destroy(tail);
+            if (tailCell < 0)
+                return;
+            if (snakes.parts[tailCell] == tail)
+                snakes.parts[tailCell] = entt::null;
+            release_cell(reg, boundary, tailCell);
+        }
+        static bool apple_update(entt::registry &reg)
+        {
+            SNAKE_PROFILE_SCOPE(TickProfiler::APPLE_UPDATE);
+            const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front());
+            Snakes &snakes = get_snakes(reg, boundary);
+            AppleIndex &appleIndex = get_apple_index(reg, boundary);
+            FreeCells &freeCells = get_free_cells(reg, boundary);
+
+            bool isAnyEaten = false;
+            for (size_t k = 0; k < snakes.count; k++)
+            {
+                Snake &snake = snakes.snakes[k];
+                const entt::entity eatenApple = snake.headCell >= 0 ? appleIndex.cells[snake.headCell] : entt::null;
+                const bool isEaten = eatenApple != entt::null;
+                Detail::do_trailing(reg, snake, isEaten);
+                if (!isEaten)
+                    continue;
+                isAnyEaten = true;
 
-                if (!isAteApple)
+                SDL_assert(reg.valid(eatenApple));
+                appleIndex.cells[snake.headCell] = entt::null; // the head stays on the cell, so it is not free
+                if (freeCells.cells.empty()) // do_trailing() has moved the body
                 {
-                    // At this point, i and j are at the neck (already spawned in).
-                    // Since no apple is eaten, we need to destroy the tail.
-                    // We can find the tail by looking at all the SnakePart
-                    // currentDirection as well as their Position to determine
-                    // where the next part should be. Have a pool of these next part
-                    // indices. The tail is the one that has a pos not in that pool.
-                    auto snakePartView = reg.view<Position, SnakePart>();
-                    std::vector<Index> indexVec;
-                    for (const auto &entity : snakePartView)
-                    {
-                        const bool isValid = reg.all_of<SnakePart, Position>(entity);
-                        SDL_assert(isValid);
-                        Position pos = reg.get<Position>(entity);
-                        const SnakePart snakePart = reg.get<SnakePart>(entity);
-                        switch (snakePart.currentDirection)
-                        {
-                        case 'w':
-                        {
-                            pos.y += 1.0f;
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex >= 0 && xIndex < boundary.x && yIndex >= 0 && yIndex < boundary.y)
-                                indexVec.push_back(Index(yIndex, xIndex));
-                            break;
-                        }
-                        case 'a':
-                        {
-                            pos.x -= 1.0f;
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex >= 0 && xIndex < boundary.x && yIndex >= 0 && yIndex < boundary.y)
-                                indexVec.push_back(Index(yIndex, xIndex));
-                            break;
-                        }
-                        case 's':
-                        {
-                            pos.y -= 1.0f;
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex >= 0 && xIndex < boundary.x && yIndex >= 0 && yIndex < boundary.y)
-                                indexVec.push_back(Index(yIndex, xIndex));
-                            break;
-                        }
-                        case 'd':
-                        {
-                            pos.x += 1.0f;
-                            long xIndex, yIndex;
-                            Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                            if (xIndex >= 0 && xIndex < boundary.x && yIndex >= 0 && yIndex < boundary.y)
-                                indexVec.push_back(Index(yIndex, xIndex));
-                            break;
-                        }
-                        }
-                    }
-                    // Now that the pool of indices of next parts are gotten,
-                    // look for the 1 part that doesn't have index within the pool.
-                    bool hasFoundTail = false;
-                    for (auto &entity : snakePartView)
-                    {
-                        const Position pos = reg.get<Position>(entity);
-                        long xIndex, yIndex;
-                        Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
-                        bool isInPool = false;
-                        for (Index index : indexVec)
-                        {
-                            if (index.i == yIndex && index.j == xIndex)
-                            {
-                                isInPool = true;
-                                break;
-                            }
-                        }
-                        if (!isInPool)
-                        {
-                            hasFoundTail = true;
-                            reg.destroy(entity);
-                            break;
-                        }
-                    }
-                    SDL_assert(hasFoundTail);
+                    reg.destroy(eatenApple);
+                    continue;
                 }
+                const long cell = freeCells.cells[draw(reg, static_cast<Sint32>(freeCells.cells.size()))];
+                freeCells.erase(cell);
+                reg.get<Position>(eatenApple) = Util::get_pos_from_index(cell % boundary.x, cell / boundary.x, boundary.y);
+                appleIndex.cells[cell] = eatenApple;
             }
+            return isAnyEaten;
         }
-        static bool apple_update(entt::registry &reg)
+        // Off the board, on an obstacle, on another head, or on a part that stays there this tick.
+        static bool is_crashed(entt::registry &reg, Snakes &snakes, const Snake &snake, const SnakeBoundary2D &boundary)
         {
-            auto map = get_map(reg);
-            struct Index
+            const Position &pos = reg.get<Position>(snake.head);
+            if (pos.x < 0.0f || pos.x >= boundary.x || pos.y < 0.0f || pos.y >= boundary.y || snake.headCell < 0)
+                return true;
+            const ObstacleLayer *obstacles = find_obstacles(reg);
+            if (obstacles != nullptr && obstacles->is_blocked(snake.headCell))
+                return true;
+            if (snake.isHeadOnHead)
+                return true;
+
+            const entt::entity part = snakes.parts[snake.headCell];
+            if (part == entt::null || part == snake.get_tail())
+                return false; // its own tail moves up as the head comes in
+            for (size_t k = 0; k < snakes.count; k++)
+            { // another snake's tail moves up too if that head entered a cell of no apple this tick
+                const Snake &other = snakes.snakes[k];
+                if (other.get_tail() != part)
+                    continue;
+                return other.headCell < 0 || other.headCell == other.previousHeadCell ||
+                       get_apple_index(reg, boundary).cells[other.headCell] != entt::null;
+            }
+            return true;
+        }
+        // Takes every crashed snake off the board while some other one still runs.
+        static void remove_crashed_snakes(entt::registry &reg)
+        {
+            const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(reg.view<SnakeBoundary2D>().front());
+            Snakes &snakes = get_snakes(reg, boundary);
+            bool isAnyCrashed = false;
+            for (size_t k = 0; k < snakes.count; k++)
+            { // all decided before any goes, as a crash may depend on another snake's tail
+                snakes.snakes[k].isCrashed = is_crashed(reg, snakes, snakes.snakes[k], boundary);
+                isAnyCrashed = isAnyCrashed || snakes.snakes[k].isCrashed;
+            }
+            if (!isAnyCrashed)
+                return;
+            for (size_t k = snakes.count; k-- > 0;)
             {
-                explicit Index(const int &_i, const int &_j) : i(_i), j(_j) {}
-                int i;
-                int j;
+                if (snakes.snakes[k].isCrashed)
+                    remove_snake(reg, snakes, k, boundary);
+            }
+        }
+        // Destroys the head and the parts of snakes.snakes[k] and frees their cells; the last
+        // snake moves into its place.
+        static void remove_snake(entt::registry &reg, Snakes &snakes, const size_t &k, const SnakeBoundary2D &boundary)
+        {
+            SDL_assert(k < snakes.count);
+            Snake &snake = snakes.snakes[k];
+            for (size_t n = 0; n < snake.length; n++)
+            {
+                const entt::entity part = snake.ring[(snake.neck + n) % snake.ring.size()];
+                const long cell = get_cell(reg.get<Position>(part), boundary);
+                reg.destroy(part);
+                if (cell >= 0 && snakes.parts[cell] == part)
+                    snakes.parts[cell] = entt::null;
+                release_cell(reg, boundary, cell);
+            }
+            snake.neck = 0U;
+            snake.length = 0U;
+            if (snake.headCell >= 0 && snakes.heads[snake.headCell] == snake.head)
+                snakes.heads[snake.headCell] = entt::null;
+            const entt::entity head = snake.head;
+            const long headCell = snake.headCell;
+            const long previousHeadCell = snake.previousHeadCell; // left this tick, before trailing could fill it
+            snake.head = entt::null;
+            snakes.count--;
+            std::swap(snakes.snakes[k], snakes.snakes[snakes.count]);
+            reg.destroy(head);
+            release_cell(reg, boundary, headCell);
+            release_cell(reg, boundary, previousHeadCell);
+        }
+        // Makes cell free again unless a head, a part, an apple or an obstacle is on it.
+        static void release_cell(entt::registry &reg, const SnakeBoundary2D &boundary, const long &cell)
+        {
+            if (cell < 0)
+                return;
+            // mid-update, so straight from reg.ctx() rather than through the rebuilding getters
+            FreeCells &freeCells = *reg.ctx().find<FreeCells>();
+            const Snakes &snakes = *reg.ctx().find<Snakes>();
+            const AppleIndex &appleIndex = *reg.ctx().find<AppleIndex>();
+            const ObstacleLayer *obstacles = find_obstacles(reg);
+            if (!freeCells.contains(cell) && snakes.heads[cell] == entt::null && snakes.parts[cell] == entt::null &&
+                appleIndex.cells[cell] == entt::null && (obstacles == nullptr || !obstacles->is_blocked(cell)))
+                freeCells.insert(cell);
+        }
+        // Builds AppleIndex, FreeCells and Snakes from the entities of the scene. A snake's ring
+        // follows its parts from the head: each part's currentDirection points at the next one
+        // towards the head, so the part pointing at the head is the neck, the one pointing at
+        // the neck comes next, and so on. A part no chain reaches stays on the board as it is.
+        static void index_board(entt::registry &reg)
+        {
+            const entt::entity scene = reg.view<SnakeBoundary2D>().front();
+            const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(scene);
+            const long cellCount = static_cast<long>(boundary.x) * boundary.y;
+            AppleIndex &appleIndex = reg.ctx().emplace<AppleIndex>();
+            appleIndex.cells.assign(static_cast<size_t>(cellCount), entt::null);
+            appleIndex.scene = scene;
+
+            FreeCells &freeCells = reg.ctx().emplace<FreeCells>();
+            const ObstacleLayer *obstacles = find_obstacles(reg);
+            freeCells.slots.assign(static_cast<size_t>(cellCount), obstacles != nullptr ? -1 : 0); // 0 while a candidate
+            if (obstacles != nullptr)
+            {
+                for (const long &cell : obstacles->freeCells)
+                    freeCells.slots[cell] = 0;
+            }
+            auto take = [&](const Position &pos)
+            {
+                const long cell = get_cell(pos, boundary);
+                if (cell >= 0)
+                    freeCells.slots[cell] = -1;
+                return cell;
             };
-            std::vector<Index> indexVec;
-            bool isEaten = false;
-            for (int i = 0; i < map.size(); i++)
+            auto appleView = reg.view<SnakeApple, Position>();
+            for (auto &entity : appleView)
             {
-                for (int j = 0; j < map[i].size(); j++)
-                {
-                    if (map[i][j] == MapSlotState::EMPTY)
-                        indexVec.push_back(Index(i, j));
-                    else if ((map[i][j] & MapSlotState::SNAKE_HEAD) && (map[i][j] & MapSlotState::APPLE))
-                    {
-                        isEaten = true;
-                    }
-                }
+                const long cell = take(appleView.get<Position>(entity));
+                if (cell >= 0)
+                    appleIndex.cells[cell] = entity;
             }
-            Detail::do_trailing(reg, isEaten);
 
-            auto respawnApple = [](entt::registry &reg, const std::vector<Index> &indexVec)
+            Snakes &snakes = reg.ctx().emplace<Snakes>();
+            snakes.parts.assign(static_cast<size_t>(cellCount), entt::null);
+            snakes.heads.assign(static_cast<size_t>(cellCount), entt::null);
+            std::vector<entt::entity> &previousParts = get_scratch(reg).entities; // part pointing at each cell
+            previousParts.assign(static_cast<size_t>(cellCount), entt::null);
+            auto snakePartView = reg.view<SnakePart, Position>();
+            for (auto &entity : snakePartView)
+            {
+                const Position &pos = snakePartView.get<Position>(entity);
+                const long cell = take(pos);
+                if (cell < 0)
+                    continue;
+                snakes.parts[cell] = entity;
+                const long nextCell = get_next_cell(pos, snakePartView.get<SnakePart>(entity).currentDirection, boundary);
+                if (nextCell >= 0 && previousParts[nextCell] == entt::null)
+                    previousParts[nextCell] = entity;
+            }
+            snakes.count = 0U;
+            auto snakeHeadView = reg.view<SnakePartHead, Position>();
+            for (auto &entity : snakeHeadView)
             {
-                auto appleView = reg.view<SnakeApple, Position>();
-                SDL_assert(appleView.storage<SnakeApple>()->size() <= 1);
-                const bool isNoApple = appleView.storage<SnakeApple>()->empty();
-                if (!isNoApple) // don't spawn in when there's no apple
+                if (snakes.count == snakes.snakes.size())
+                    snakes.snakes.emplace_back(); // past reserve()
+                Snake &snake = snakes.snakes[snakes.count++];
+                const long cell = take(snakeHeadView.get<Position>(entity));
+                snake.head = entity;
+                snake.headCell = cell;
+                snake.previousHeadCell = cell;
+                snake.isHeadOnHead = false;
+                snake.neck = 0U;
+                snake.length = 0U;
+                if (cell < 0)
+                    continue;
+                if (snakes.heads[cell] != entt::null)
                 {
-                    if (indexVec.empty())
-                        reg.destroy(appleView.front());
-                    else
-                    {
-                        Position &applePos = reg.get<Position>(appleView.front());
-                        const Sint32 indexVexIndex = SDL_rand(indexVec.size());
-                        const int y = indexVec[indexVexIndex].i;
-                        const int x = indexVec[indexVexIndex].j;
-
-                        auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
-                        SDL_assert(snakeBoundaryView.size() == 1);
-                        const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
-                        applePos = Util::get_pos_from_index(x, y, boundary.y);
-                    }
+                    snake.isHeadOnHead = true;
+                    if (Snake *other = snakes.find(snakes.heads[cell]))
+                        other->isHeadOnHead = true;
                 }
-            };
+                snakes.heads[cell] = entity;
+                for (long nextCell = cell;;)
+                {
+                    const entt::entity part = previousParts[nextCell];
+                    if (part == entt::null)
+                        break;
+                    previousParts[nextCell] = entt::null; // one chain per part
+                    const long partCell = get_cell(reg.get<Position>(part), boundary);
+                    if (partCell == cell)
+                        break; // under the head, not behind it
+                    snake.push_tail(part);
+                    nextCell = partCell;
+                }
+            }
 
-            if (isEaten)
+            freeCells.cells.clear();
+            for (long cell = 0; cell < cellCount; cell++)
+            {
+                if (freeCells.slots[cell] < 0)
+                    continue;
+                freeCells.slots[cell] = static_cast<Sint32>(freeCells.cells.size());
+                freeCells.cells.push_back(cell);
+            }
+        }
+        // Moves every head to the cell its Position is on now in Snakes::heads, so the heads
+        // the translate system moved are seen by the lookups. Clears all the cells left before
+        // taking the new ones, so a head entering the cell another head leaves is no collision.
+        static void sync_heads(entt::registry &reg, Snakes &snakes, const SnakeBoundary2D &boundary)
+        {
+            bool isAnyMoved = false;
+            for (size_t k = 0; k < snakes.count; k++)
             {
-                respawnApple(reg, indexVec);
-                map = get_map(reg);
-
-                bool hasErased = false;
-                for (auto it = indexVec.begin(); it != indexVec.end();) // search for conflicting spots since the head was detached
-                {                                                       // solves apple at neck issue
-                    Index index = *it;
-                    if ((map[index.i][index.j] & MapSlotState::APPLE) && map[index.i][index.j] > MapSlotState::APPLE)
-                    {
-                        hasErased = true;
-                        it = indexVec.erase(it); // erase() returns iterator to next element
-                    }
-                    else
-                        ++it;
+                Snake &snake = snakes.snakes[k];
+                const long cell = get_cell(reg.get<Position>(snake.head), boundary);
+                if (cell == snake.headCell)
+                    continue;
+                isAnyMoved = true;
+                if (snake.headCell >= 0 && snakes.heads[snake.headCell] == snake.head)
+                    snakes.heads[snake.headCell] = entt::null;
+                snake.headCell = cell;
+            }
+            if (!isAnyMoved)
+                return;
+            FreeCells &freeCells = *reg.ctx().find<FreeCells>();
+            for (size_t k = 0; k < snakes.count; k++)
+            { // the heads that moved are the ones missing from their cell
+                Snake &snake = snakes.snakes[k];
+                if (snake.headCell < 0 || snakes.heads[snake.headCell] == snake.head)
+                    continue;
+                if (snakes.heads[snake.headCell] != entt::null)
+                {
+                    snake.isHeadOnHead = true;
+                    if (Snake *other = snakes.find(snakes.heads[snake.headCell]))
+                        other->isHeadOnHead = true;
                 }
-                if (hasErased)
-                    respawnApple(reg, indexVec);
+                snakes.heads[snake.headCell] = snake.head;
+                if (freeCells.contains(snake.headCell))
+                    freeCells.erase(snake.headCell);
             }
-
-            return isEaten;
+        }
+        static AppleIndex &get_apple_index(entt::registry &reg, const SnakeBoundary2D &boundary)
+        {
+            AppleIndex *appleIndex = reg.ctx().find<AppleIndex>();
+            const Snakes *snakes = reg.ctx().find<Snakes>();
+            if (appleIndex == nullptr || appleIndex->scene != reg.view<SnakeBoundary2D>().front() ||
+                appleIndex->cells.size() != static_cast<size_t>(boundary.x) * static_cast<size_t>(boundary.y) ||
+                snakes == nullptr || snakes->count != reg.view<SnakePartHead>().size())
+            { // init() was skipped, the registry was cleared and repopulated since (reg.clear() keeps
+              // reg.ctx()), or the host added or removed a snake
+                index_board(reg);
+                appleIndex = reg.ctx().find<AppleIndex>();
+            }
+            return *appleIndex;
+        }
+        // Up to date with the scene, like get_apple_index().
+        static FreeCells &get_free_cells(entt::registry &reg, const SnakeBoundary2D &boundary)
+        {
+            get_apple_index(reg, boundary);
+            return reg.ctx().emplace<FreeCells>();
+        }
+        // Up to date with the scene like get_apple_index(), and with where the heads are now.
+        static Snakes &get_snakes(entt::registry &reg, const SnakeBoundary2D &boundary)
+        {
+            get_apple_index(reg, boundary);
+            Snakes &snakes = reg.ctx().emplace<Snakes>();
+            sync_heads(reg, snakes, boundary);
+            return snakes;
+        }
+        // The KeyControl of snakeHead's own, given one on first use, starting from the scene's.
+        static KeyControl &get_key_control(entt::registry &reg, const entt::entity &snakeHead)
+        {
+            SDL_assert(reg.all_of<SnakePartHead>(snakeHead));
+            if (KeyControl *keyControl = reg.try_get<KeyControl>(snakeHead))
+                return *keyControl;
+            const KeyControl *sceneKeyControl = reg.try_get<KeyControl>(reg.view<SnakeBoundary2D>().front());
+            return reg.emplace<KeyControl>(snakeHead, sceneKeyControl != nullptr ? *sceneKeyControl : KeyControl{});
+        }
+        static State &get_state(entt::registry &reg) { return reg.ctx().emplace<State>(); }
+        static Scratch &get_scratch(entt::registry &reg) { return reg.ctx().emplace<Scratch>(); }
+        // y * x + x of the cell pos is on, -1 off the board.
+        static long get_cell(const Position &pos, const SnakeBoundary2D &boundary)
+        {
+            long x, y;
+            Util::get_index_from_pos(pos, &x, &y, boundary.y);
+            if (x < 0 || y < 0 || x >= boundary.x || y >= boundary.y)
+                return -1L;
+            return y * boundary.x + x;
+        }
+        // The cell a part on pos moving in direction heads to, the next one towards the head.
+        static long get_next_cell(const Position &pos, const char &direction, const SnakeBoundary2D &boundary)
+        {
+            Position next = pos;
+            switch (direction)
+            {
+            case 'w':
+                next.y += 1.0f;
+                break;
+            case 'a':
+                next.x -= 1.0f;
+                break;
+            case 's':
+                next.y -= 1.0f;
+                break;
+            case 'd':
+                next.x += 1.0f;
+                break;
+            default:
+                return -1L;
+            }
+            return get_cell(next, boundary);
+        }
+        // Uniform in [0, n), from the registry's own stream once seed() ran for it.
+        static Sint32 draw(entt::registry &reg, const Sint32 &n)
+        {
+            State &state = get_state(reg);
+            return state.hasOwnRandom ? SDL_rand_r(&state.randomState, n) : SDL_rand(n);
         }
     } // namespace Detail
 
+    // The keys of the scene: every KeyControl, the scene's and the ones on heads, so every snake
+    // follows them. The overloads taking a head steer that snake alone, see Detail::get_key_control().
     namespace Control
     {
         static void shift_key_up(entt::registry &reg)
         {
-            auto keyControlView = reg.view<KeyControl>();
-            SDL_assert(keyControlView.size() == 1);
-            keyControlView.each([](KeyControl &control)
-                                { control.isShiftKeyDown = false; });
+            reg.view<KeyControl>().each([](KeyControl &control)
+                                       { control.isShiftKeyDown = false; });
         }
         static void shift_key_down(entt::registry &reg)
         {
-            auto keyControlView = reg.view<KeyControl>();
-            SDL_assert(keyControlView.size() == 1);
-            keyControlView.each([](KeyControl &control)
-                                { control.isShiftKeyDown = true; });
+            reg.view<KeyControl>().each([](KeyControl &control)
+                                       { control.isShiftKeyDown = true; });
         }
         static void up_key_down(entt::registry &reg)
         {
-            auto keyControlView = reg.view<KeyControl>();
-            SDL_assert(keyControlView.size() == 1);
-            keyControlView.each([](KeyControl &control)
-                                { control.lastMovementKeyDown = 'w'; });
+            reg.view<KeyControl>().each([](KeyControl &control)
+                                       { control.lastMovementKeyDown = 'w'; });
         }
         static void left_key_down(entt::registry &reg)
         {
-            auto keyControlView = reg.view<KeyControl>();
-            SDL_assert(keyControlView.size() == 1);
-            keyControlView.each([](KeyControl &control)
-                                { control.lastMovementKeyDown = 'a'; });
+            reg.view<KeyControl>().each([](KeyControl &control)
+                                       { control.lastMovementKeyDown = 'a'; });
         }
         static void down_key_down(entt::registry &reg)
         {
-            auto keyControlView = reg.view<KeyControl>();
-            SDL_assert(keyControlView.size() == 1);
-            keyControlView.each([](KeyControl &control)
-                                { control.lastMovementKeyDown = 's'; });
+            reg.view<KeyControl>().each([](KeyControl &control)
+                                       { control.lastMovementKeyDown = 's'; });
         }
         static void right_key_down(entt::registry &reg)
         {
-            auto keyControlView = reg.view<KeyControl>();
-            SDL_assert(keyControlView.size() == 1);
-            keyControlView.each([](KeyControl &control)
-                                { control.lastMovementKeyDown = 'd'; });
+            reg.view<KeyControl>().each([](KeyControl &control)
+                                       { control.lastMovementKeyDown = 'd'; });
         }
+        static void shift_key_up(entt::registry &reg, const entt::entity &snakeHead) { Detail::get_key_control(reg, snakeHead).isShiftKeyDown = false; }
+        static void shift_key_down(entt::registry &reg, const entt::entity &snakeHead) { Detail::get_key_control(reg, snakeHead).isShiftKeyDown = true; }
+        static void up_key_down(entt::registry &reg, const entt::entity &snakeHead) { Detail::get_key_control(reg, snakeHead).lastMovementKeyDown = 'w'; }
+        static void left_key_down(entt::registry &reg, const entt::entity &snakeHead) { Detail::get_key_control(reg, snakeHead).lastMovementKeyDown = 'a'; }
+        static void down_key_down(entt::registry &reg, const entt::entity &snakeHead) { Detail::get_key_control(reg, snakeHead).lastMovementKeyDown = 's'; }
+        static void right_key_down(entt::registry &reg, const entt::entity &snakeHead) { Detail::get_key_control(reg, snakeHead).lastMovementKeyDown = 'd'; }
     } // namespace Control
 
     namespace Util
@@ -810,16 +1227,17 @@ namespace SnakeGameplaySystem
 
     namespace Debug
     {
+        // Of the first snake when there are several.
         static Position get_snake_head_pos(const entt::registry &reg)
         {
             auto view = reg.view<Position, SnakePartHead>();
-            SDL_assert(view.storage<SnakePartHead>()->size() == 1);
+            SDL_assert(view.begin() != view.end());
             return reg.get<Position>(view.front());
         }
         static Velocity get_snake_head_velocity(const entt::registry &reg)
         {
             auto view = reg.view<Velocity, SnakePartHead>();
-            SDL_assert(view.storage<SnakePartHead>()->size() == 1);
+            SDL_assert(view.begin() != view.end());
             return reg.get<Velocity>(view.front());
         }
 
@@ -838,6 +1256,8 @@ namespace SnakeGameplaySystem
                         str += "x";
                     if (static_cast<Uint8>(map[i][j]) & APPLE)
                         str += "@";
+                    if (static_cast<Uint8>(map[i][j]) & OBSTACLE)
+                        str += "#";
                     str += " "; // allows manual checking for collisions
                 }
                 if (i < map.size() - 1)
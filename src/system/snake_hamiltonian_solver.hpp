@@ -0,0 +1,259 @@
+#ifndef SRC_SYSTEM_SNAKE_HAMILTONIAN_SOLVER_HPP
+#define SRC_SYSTEM_SNAKE_HAMILTONIAN_SOLVER_HPP
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+#include <entt/entt.hpp>
+#include <sigslot/signal.hpp>
+
+#include <component/position.hpp>
+#include <component/snake_apple.hpp>
+#include <component/snake_autopilot.hpp>
+#include <component/snake_boundary_2d.hpp>
+#include <component/snake_part.hpp>
+#include <component/snake_part_head.hpp>
+#include <system/snake_gameplay_system.hpp>
+
+#include <profiler/tick_profiler.hpp>
+#include <profiler/trace_recorder.hpp>
+
+// Steers the snake along a Hamiltonian cycle of the board so that a game
+// always ends in SnakeGameplaySystem::is_game_success(). Only active while
+// a SnakeAutopilot component exists in the registry, no obstacles are loaded and
+// the scene holds a single snake.
+namespace SnakeHamiltonianSolver
+{
+    struct Cycle
+    {
+        int width;
+        int height;
+        std::vector<long> cells; // position in cycle -> i * width + j
+        std::vector<long> order; // i * width + j -> position in cycle
+    }; // struct Cycle
+
+    static constexpr long SHORTCUT_MARGIN = 3L;       // free cells kept between the head and the tail when skipping ahead
+    static constexpr long SHORTCUT_MAX_FILL_DIV = 2L; // shortcuts are only taken while the snake fills < 1/2 of the board
+
+    // Shared by every registry, e.g. the games of a SnakeEnvironment stepped by a worker pool.
+    // Map nodes never move, so a returned cycle stays valid after the lock is released.
+    inline std::mutex cycleCacheMutex;
+    inline std::map<std::pair<int, int>, Cycle> cycleCache;
+
+    namespace Detail
+    {
+        static bool build_cycle(Cycle &cycle);
+    } // namespace Detail
+
+    static const Cycle *get_cycle(const SnakeBoundary2D &boundary);
+    static char get_next_direction(entt::registry &reg);
+
+    static void iterate(entt::registry &reg)
+    {
+        SNAKE_PROFILE_SCOPE(TickProfiler::HAMILTONIAN_SOLVER);
+        SNAKE_TRACE_SCOPE("SnakeHamiltonianSolver::iterate");
+        auto autopilotView = reg.view<SnakeAutopilot>();
+        if (autopilotView.empty())
+            return;
+        if (SnakeGameplaySystem::is_game_success(reg) || SnakeGameplaySystem::is_game_failure(reg))
+            return;
+
+        switch (get_next_direction(reg))
+        {
+        case 'w':
+            SnakeGameplaySystem::Control::up_key_down(reg);
+            break;
+        case 'a':
+            SnakeGameplaySystem::Control::left_key_down(reg);
+            break;
+        case 's':
+            SnakeGameplaySystem::Control::down_key_down(reg);
+            break;
+        case 'd':
+            SnakeGameplaySystem::Control::right_key_down(reg);
+            break;
+        default:
+            break;
+        }
+    }
+    static void update(entt::registry &reg) { return iterate(reg); }
+
+    // NOTE: connect before SnakeGameplaySystem so the chosen key is applied in the same tick
+    static bool init(sigslot::signal<entt::registry &> &signal)
+    {
+        static std::list<sigslot::signal<entt::registry &> *> regSignalArray;
+        bool ret = true;
+        for (auto connectedSignal : regSignalArray)
+        {
+            if (connectedSignal == &signal)
+            {
+                ret = false;
+                break;
+            }
+        }
+        if (ret)
+        {
+            signal.connect(SnakeHamiltonianSolver::iterate);
+            regSignalArray.push_back(&signal);
+        }
+        return ret;
+    }
+
+    static const Cycle *get_cycle(const SnakeBoundary2D &boundary)
+    {
+        const std::pair<int, int> key(boundary.x, boundary.y);
+        std::lock_guard<std::mutex> lock(cycleCacheMutex);
+        auto it = cycleCache.find(key);
+        if (it == cycleCache.end())
+        {
+            Cycle cycle;
+            cycle.width = boundary.x;
+            cycle.height = boundary.y;
+            if (!Detail::build_cycle(cycle))
+            {
+                cycle.cells.clear();
+                cycle.order.clear();
+            }
+            it = cycleCache.emplace(key, std::move(cycle)).first;
+        }
+        if (it->second.cells.empty())
+            return nullptr;
+        return &it->second;
+    }
+
+    static char get_next_direction(entt::registry &reg)
+    {
+        auto snakeBoundaryView = reg.view<SnakeBoundary2D>();
+        SDL_assert(snakeBoundaryView.size() == 1);
+        const SnakeBoundary2D boundary = reg.get<SnakeBoundary2D>(snakeBoundaryView.front());
+        const Cycle *cycle = get_cycle(boundary);
+        if (cycle == nullptr || SnakeGameplaySystem::find_obstacles(reg) != nullptr)
+            return '\t'; // the cycle covers every cell, so it only exists on an open board
+
+        const long cellCount = static_cast<long>(cycle->cells.size());
+        auto getCell = [&boundary](const Position &pos)
+        {
+            long xIndex, yIndex;
+            SnakeGameplaySystem::Util::get_index_from_pos(pos, &xIndex, &yIndex, boundary.y);
+            if (xIndex < 0 || xIndex >= boundary.x || yIndex < 0 || yIndex >= boundary.y)
+                return -1L;
+            return yIndex * boundary.x + xIndex;
+        };
+
+        auto snakeHeadView = reg.view<SnakePartHead, Position>();
+        if (snakeHeadView.storage<SnakePartHead>()->size() != 1)
+            return '\t'; // the cycle has room for one snake only
+        const long headCell = getCell(reg.get<Position>(snakeHeadView.front()));
+        if (headCell < 0)
+            return '\t';
+        const long headOrder = cycle->order[headCell];
+        auto getDistance = [&](const long &cell)
+        { return (cycle->order[cell] - headOrder + cellCount) % cellCount; };
+
+        // Every body part lies behind the head along the cycle, so the
+        // closest one ahead of the head is the tail.
+        long tailDistance = cellCount;
+        auto snakePartView = reg.view<SnakePart, Position>();
+        for (auto &entity : snakePartView)
+        {
+            const long cell = getCell(snakePartView.get<Position>(entity));
+            if (cell < 0)
+                continue;
+            const long distance = getDistance(cell);
+            if (distance > 0 && distance < tailDistance)
+                tailDistance = distance;
+        }
+
+        long appleDistance = cellCount;
+        auto appleView = reg.view<SnakeApple, Position>();
+        for (auto &entity : appleView)
+        {
+            const long cell = getCell(appleView.get<Position>(entity));
+            if (cell >= 0 && getDistance(cell) > 0)
+                appleDistance = SDL_min(appleDistance, getDistance(cell));
+        }
+
+        long nextCell = cycle->cells[(headOrder + 1L) % cellCount];
+        const auto &autopilot = reg.get<SnakeAutopilot>(reg.view<SnakeAutopilot>().front());
+        const long snakeLength = static_cast<long>(SnakeGameplaySystem::get_score(reg)) + 1L;
+        if (autopilot.isShortcutEnabled && snakeLength * SHORTCUT_MAX_FILL_DIV < cellCount)
+        {
+            const long i = headCell / boundary.x, j = headCell % boundary.x;
+            const long neighbours[4][2] = {{i - 1, j}, {i, j - 1}, {i + 1, j}, {i, j + 1}};
+            long bestDistance = 1L;
+            for (const auto &neighbour : neighbours)
+            {
+                if (neighbour[0] < 0 || neighbour[0] >= boundary.y || neighbour[1] < 0 || neighbour[1] >= boundary.x)
+                    continue;
+                const long cell = neighbour[0] * boundary.x + neighbour[1];
+                const long distance = getDistance(cell);
+                if (distance > bestDistance && distance <= appleDistance && distance < tailDistance - SHORTCUT_MARGIN)
+                {
+                    bestDistance = distance;
+                    nextCell = cell;
+                }
+            }
+        }
+
+        if (nextCell == headCell - boundary.x)
+            return 'w';
+        if (nextCell == headCell - 1L)
+            return 'a';
+        if (nextCell == headCell + boundary.x)
+            return 's';
+        if (nextCell == headCell + 1L)
+            return 'd';
+        SDL_assert(false); // cycle cells are always adjacent
+        return '\t';
+    }
+
+    namespace Detail
+    {
+        static bool build_cycle(Cycle &cycle)
+        { // boustrophedon over columns 1.. with column 0 as the way back; needs an even row count
+            const bool isTransposed = cycle.height % 2 != 0;
+            const long rows = isTransposed ? cycle.width : cycle.height;
+            const long cols = isTransposed ? cycle.height : cycle.width;
+            if (rows < 2 || cols < 2 || rows % 2 != 0)
+                return false;
+
+            cycle.cells.clear();
+            cycle.cells.reserve(rows * cols);
+            auto push = [&cycle, &isTransposed](const long &row, const long &col)
+            {
+                if (isTransposed)
+                    cycle.cells.push_back(col * cycle.width + row);
+                else
+                    cycle.cells.push_back(row * cycle.width + col);
+            };
+
+            for (long row = 0; row < rows; row++)
+            {
+                if (row % 2 == 0)
+                {
+                    for (long col = (row == 0 ? 0L : 1L); col < cols; col++)
+                        push(row, col);
+                }
+                else
+                {
+                    for (long col = cols - 1; col >= 1; col--)
+                        push(row, col);
+                }
+            }
+            for (long row = rows - 1; row >= 1; row--)
+                push(row, 0L);
+
+            cycle.order.assign(cycle.cells.size(), -1L);
+            for (long k = 0; k < static_cast<long>(cycle.cells.size()); k++)
+                cycle.order[cycle.cells[k]] = k;
+            return true;
+        }
+    } // namespace Detail
+} // namespace SnakeHamiltonianSolver
+
+#endif // SRC_SYSTEM_SNAKE_HAMILTONIAN_SOLVER_HPP
@@ -0,0 +1,23 @@
+#ifndef SRC_SYSTEM_SYSTEM_PIPELINE_HPP
+#define SRC_SYSTEM_SYSTEM_PIPELINE_HPP
+
+#include <cstddef>
+
+#include <entt/entt.hpp>
+
+// Runs a fixed list of systems in order, e.g.
+//   using GameplayPipeline = SystemPipeline<SystemTranslate2D::iterate, SnakeGameplaySystem::iterate>;
+//   GameplayPipeline::iterate(reg);
+// The systems are template arguments, so every call is direct and can be
+// inlined: no slot list, no lock and no type-erased call per tick as with a
+// sigslot::signal. Use a signal where systems must be connected at run time.
+template <void (*...Systems)(entt::registry &)>
+struct SystemPipeline
+{
+    static constexpr size_t SYSTEM_COUNT = sizeof...(Systems);
+
+    static void iterate(entt::registry &reg) { (Systems(reg), ...); }
+    static void update(entt::registry &reg) { return iterate(reg); }
+}; // struct SystemPipeline
+
+#endif // SRC_SYSTEM_SYSTEM_PIPELINE_HPP
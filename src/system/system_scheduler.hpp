@@ -0,0 +1,148 @@
+#ifndef SRC_SYSTEM_SYSTEM_SCHEDULER_HPP
+#define SRC_SYSTEM_SYSTEM_SCHEDULER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <entt/entt.hpp>
+
+#include <system/worker_pool.hpp>
+
+// Component lists for SystemScheduler::add(). Writes<entt::entity> declares a
+// structural change (creating or destroying entities, adding or removing
+// components), which conflicts with every other system. Ctx<Type> in either
+// list declares access to the reg.ctx() variable of that type, which then
+// conflicts like a component, e.g. Writes<Ctx<SnakeGameplaySystem::State>>.
+template <typename Type>
+struct Ctx
+{
+}; // struct Ctx
+template <typename... Components>
+struct Reads
+{
+}; // struct Reads
+template <typename... Components>
+struct Writes
+{
+}; // struct Writes
+
+// Runs systems that declare the components they touch. Systems are grouped
+// into stages: a system goes into the stage after the last earlier system it
+// conflicts with (one writes what the other reads or writes), so conflicting
+// systems always run in the order they were added and the results are those
+// of running every system in that order. The systems of a stage run in
+// parallel on the WorkerPool.
+//
+// A system MUST declare every component it views or gets and every context
+// variable it uses, including ones it only reads; iterate() creates their
+// pools and variables beforehand so that neither is created while systems run
+// concurrently. Context variables MUST be default-constructible.
+class SystemScheduler
+{
+public:
+    using System = void (*)(entt::registry &);
+
+    explicit SystemScheduler(WorkerPool &pool) : pool(pool) {}
+
+    template <typename... ReadComponents, typename... WriteComponents>
+    void add(const System &system, Reads<ReadComponents...>, Writes<WriteComponents...>)
+    {
+        SDL_assert(system != nullptr);
+        Entry entry;
+        entry.system = system;
+        entry.reads = {std::type_index(typeid(ReadComponents))...};
+        entry.writes = {std::type_index(typeid(WriteComponents))...};
+        entry.isStructural = (std::is_same_v<WriteComponents, entt::entity> || ...);
+        entry.assure_pools = [](entt::registry &reg)
+        {
+            (assure_pool<ReadComponents>(reg), ...);
+            (assure_pool<WriteComponents>(reg), ...);
+        };
+
+        size_t stage = 0U;
+        for (size_t i = 0U; i < entries.size(); i++)
+        {
+            if (is_conflicting(entries[i], entry))
+                stage = std::max(stage, entryStages[i] + 1U);
+        }
+        if (stage == stages.size())
+            stages.emplace_back();
+        stages[stage].push_back(entries.size());
+        entryStages.push_back(stage);
+        entries.push_back(std::move(entry));
+    }
+
+    void iterate(entt::registry &reg)
+    {
+        for (const Entry &entry : entries)
+            entry.assure_pools(reg);
+        for (const std::vector<size_t> &stage : stages)
+        {
+            if (stage.size() == 1U)
+                entries[stage.front()].system(reg);
+            else
+                pool.run(stage.size(), [this, &stage, &reg](const size_t &i)
+                         { entries[stage[i]].system(reg); });
+        }
+    }
+    void update(entt::registry &reg) { return iterate(reg); }
+
+    size_t get_system_count() const { return entries.size(); }
+    size_t get_stage_count() const { return stages.size(); }
+    size_t get_stage(const size_t &system) const { return entryStages[system]; } // systems in the order added
+
+private:
+    struct Entry
+    {
+        System system = nullptr;
+        std::vector<std::type_index> reads;
+        std::vector<std::type_index> writes;
+        bool isStructural = false;
+        void (*assure_pools)(entt::registry &) = nullptr;
+    }; // struct Entry
+
+    template <typename Component>
+    struct Assure
+    {
+        static void run(entt::registry &reg) { reg.storage<Component>(); }
+    }; // struct Assure
+    template <typename Type>
+    struct Assure<Ctx<Type>>
+    {
+        static void run(entt::registry &reg) { reg.ctx().emplace<Type>(); } // kept if already there
+    }; // struct Assure
+
+    template <typename Component>
+    static void assure_pool(entt::registry &reg)
+    {
+        if constexpr (!std::is_same_v<Component, entt::entity>)
+            Assure<Component>::run(reg);
+    }
+
+    static bool is_overlapping(const std::vector<std::type_index> &a, const std::vector<std::type_index> &b)
+    {
+        for (const std::type_index &component : a)
+        {
+            if (std::find(b.begin(), b.end(), component) != b.end())
+                return true;
+        }
+        return false;
+    }
+
+    static bool is_conflicting(const Entry &a, const Entry &b)
+    {
+        return a.isStructural || b.isStructural || is_overlapping(a.writes, b.writes) ||
+               is_overlapping(a.writes, b.reads) || is_overlapping(a.reads, b.writes);
+    }
+
+    WorkerPool &pool;
+    std::vector<Entry> entries;
+    std::vector<size_t> entryStages;        // per entry
+    std::vector<std::vector<size_t>> stages; // entry indices
+}; // class SystemScheduler
+
+#endif // SRC_SYSTEM_SYSTEM_SCHEDULER_HPP
@@ -0,0 +1,134 @@
+#ifndef SRC_SYSTEM_WORKER_POOL_HPP
+#define SRC_SYSTEM_WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <SDL3/SDL_assert.h>
+#include <SDL3/SDL_stdinc.h>
+
+// Persistent threads for data-parallel work inside a tick. run() hands out
+// task indices to the workers and to the calling thread, then returns once
+// every task is done; it neither allocates nor type-erases through
+// std::function. Only one thread may call run() at a time; a task calling
+// run() on its own pool runs the inner tasks inline.
+class WorkerPool
+{
+public:
+    // workerCount threads besides the caller; 0 runs every task on the caller.
+    explicit WorkerPool(const size_t &workerCount)
+    {
+        workers.reserve(workerCount);
+        for (size_t i = 0U; i < workerCount; i++)
+            workers.emplace_back(&WorkerPool::worker_loop, this);
+    }
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopRequested = true;
+        }
+        startCondition.notify_all();
+        for (std::thread &worker : workers)
+            worker.join();
+    }
+
+    // Worker threads for the available cores, the calling thread being one of them.
+    static size_t get_default_worker_count()
+    {
+        const unsigned int cores = std::thread::hardware_concurrency();
+        return cores > 1U ? cores - 1U : 0U;
+    }
+
+    size_t get_thread_count() const { return workers.size() + 1U; } // caller included
+
+    // Calls task(i) once for every i in [0, taskCount), in no particular order or thread.
+    template <typename Func>
+    void run(const size_t &taskCount, Func &&task)
+    {
+        if (workers.empty() || taskCount <= 1U || get_current_pool() == this)
+        {
+            for (size_t i = 0U; i < taskCount; i++)
+                task(i);
+            return;
+        }
+        using Task = std::remove_reference_t<Func>;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            invoke = [](void *context, const size_t &i)
+            { (*static_cast<Task *>(context))(i); };
+            context = const_cast<void *>(static_cast<const void *>(&task));
+            this->taskCount = taskCount;
+            nextTask.store(0U, std::memory_order_relaxed);
+            activeWorkerCount = workers.size();
+            generation++;
+        }
+        startCondition.notify_all();
+        run_tasks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCondition.wait(lock, [this]()
+                           { return activeWorkerCount == 0U; });
+    }
+
+private:
+    void worker_loop()
+    {
+        Uint64 seenGeneration = 0U;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            startCondition.wait(lock, [this, &seenGeneration]()
+                                { return isStopRequested || generation != seenGeneration; });
+            if (isStopRequested)
+                return;
+            seenGeneration = generation;
+            lock.unlock();
+            run_tasks();
+            lock.lock();
+            if (--activeWorkerCount == 0U)
+                doneCondition.notify_one();
+        }
+    }
+
+    static WorkerPool *&get_current_pool()
+    { // the pool whose tasks this thread is running, if any
+        static thread_local WorkerPool *currentPool = nullptr;
+        return currentPool;
+    }
+
+    void run_tasks()
+    {
+        WorkerPool *const outerPool = get_current_pool();
+        get_current_pool() = this;
+        while (true)
+        {
+            const size_t i = nextTask.fetch_add(1U, std::memory_order_relaxed);
+            if (i >= taskCount)
+                break;
+            invoke(context, i);
+        }
+        get_current_pool() = outerPool;
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex; // guards everything below but nextTask; the task fields are set before generation changes
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+    void (*invoke)(void *, const size_t &) = nullptr;
+    void *context = nullptr;
+    size_t taskCount = 0U;
+    std::atomic<size_t> nextTask{0U};
+    size_t activeWorkerCount = 0U;
+    Uint64 generation = 0U;
+    bool isStopRequested = false;
+}; // class WorkerPool
+
+#endif // SRC_SYSTEM_WORKER_POOL_HPP
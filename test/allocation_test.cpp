@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <component/position.hpp>
+#include <component/delta_time.hpp>
+#include <component/key_control.hpp>
+#include <component/snake_part.hpp>
+#include <component/snake_part_head.hpp>
+#include <component/snake_boundary_2d.hpp>
+#include <component/snake_apple.hpp>
+#include <component/velocity.hpp>
+#include <profiler/allocation_counter.hpp>
+#include <system/translate_2d.hpp>
+#include <system/snake_gameplay_system.hpp>
+
+SNAKE_DEFINE_COUNTING_OPERATOR_NEW(); // this executable only, so main_test keeps the default allocator
+
+// Whether a tick or a restart allocates depends on how the EnTT in use grows and
+// clears its pools, so these tests are only meaningful against the submodule.
+
+namespace
+{
+    constexpr int BOARD_SIZE = 20;
+    constexpr long HEAD_ROW = 10L;
+    constexpr long HEAD_COLUMN = 5L;
+
+    // Snake of length 4 heading right along row HEAD_ROW with the apples out of its way,
+    // along row 0 from the right.
+    void make_scene(entt::registry &registry, const long &appleCount = 1L)
+    {
+        auto entity = registry.create();
+        registry.emplace<KeyControl>(entity, 'd', false);
+        registry.emplace<DeltaTime>(entity, 25U);
+        registry.emplace<SnakeBoundary2D>(entity, BOARD_SIZE, BOARD_SIZE);
+
+        for (long k = 0L; k < appleCount; k++)
+        {
+            auto appleEntity = registry.create();
+            registry.emplace<Position>(appleEntity, SnakeGameplaySystem::Util::get_pos_from_index(BOARD_SIZE - 1L - k, 0L, BOARD_SIZE));
+            registry.emplace<SnakeApple>(appleEntity);
+        }
+
+        auto snakeHeadEntity = registry.create();
+        registry.emplace<Position>(snakeHeadEntity, SnakeGameplaySystem::Util::get_pos_from_index(HEAD_COLUMN, HEAD_ROW, BOARD_SIZE));
+        registry.emplace<Velocity>(snakeHeadEntity, 0.0f, 0.0f);
+        registry.emplace<SnakePartHead>(snakeHeadEntity, 10.0f, 1.0f); // 0.25 unit per tick
+
+        for (long k = 1L; k <= 3L; k++)
+        {
+            auto snakePartEntity = registry.create();
+            registry.emplace<SnakePart>(snakePartEntity, 'd');
+            registry.emplace<Position>(snakePartEntity, SnakeGameplaySystem::Util::get_pos_from_index(HEAD_COLUMN - k, HEAD_ROW, BOARD_SIZE));
+        }
+        SnakeGameplaySystem::init(registry);
+    }
+
+    void tick(entt::registry &registry)
+    {
+        SystemTranslate2D::iterate(registry);
+        SnakeGameplaySystem::iterate(registry);
+    }
+
+    TEST(AllocationTest, SteadyStateTickDoesNotAllocate)
+    {
+        entt::registry registry;
+        SnakeGameplaySystem::reserve(registry, {BOARD_SIZE, BOARD_SIZE}); // like the game, so growing has room
+        make_scene(registry);
+        for (int i = 0; i < 8; i++) // warm-up: two cells, so every scratch buffer has grown
+            tick(registry);
+        { // an apple three cells ahead, eaten inside the measured ticks
+            auto appleEntity = registry.create();
+            registry.emplace<Position>(appleEntity, SnakeGameplaySystem::Util::get_pos_from_index(HEAD_COLUMN + 5L, HEAD_ROW, BOARD_SIZE));
+            registry.emplace<SnakeApple>(appleEntity);
+            SnakeGameplaySystem::init(registry);
+        }
+
+        const Uint64 allocationCount = AllocationCounter::get_allocation_count();
+        for (int i = 0; i < 32; i++) // eats, respawns the apple and grows a part
+            tick(registry);
+        EXPECT_EQ(AllocationCounter::get_allocation_count() - allocationCount, 0U);
+
+        long x, y;
+        SnakeGameplaySystem::Util::get_index_from_pos(SnakeGameplaySystem::Debug::get_snake_head_pos(registry), &x, &y, BOARD_SIZE);
+        EXPECT_EQ(x, HEAD_COLUMN + 10L);
+        EXPECT_EQ(y, HEAD_ROW);
+        EXPECT_GE(SnakeGameplaySystem::get_score(registry), 4UL); // the respawn MAY land ahead too
+        EXPECT_EQ(registry.view<SnakeApple>().size(), 2U);
+        EXPECT_FALSE(SnakeGameplaySystem::is_game_failure(registry));
+    }
+
+    TEST(AllocationTest, RestartDoesNotAllocate)
+    {
+        entt::registry registry;
+        SnakeGameplaySystem::reserve(registry, {BOARD_SIZE, BOARD_SIZE});
+        make_scene(registry);
+        for (int i = 0; i < 8; i++)
+            tick(registry);
+        registry.clear(); // warm-up: the first clear() may size the registry's own entity bookkeeping
+
+        const Uint64 allocationCount = AllocationCounter::get_allocation_count();
+        for (int game = 0; game < 4; game++)
+        { // same steps as the restart of the game and of SnakeEnvironment::reset()
+            registry.clear();
+            SnakeGameplaySystem::reserve(registry, {BOARD_SIZE, BOARD_SIZE});
+            make_scene(registry);
+            for (int i = 0; i < 32; i++)
+                tick(registry);
+        }
+        EXPECT_EQ(AllocationCounter::get_allocation_count() - allocationCount, 0U);
+        EXPECT_EQ(SnakeGameplaySystem::get_score(registry), 3UL);
+    }
+
+    TEST(AllocationTest, RestartWithManyApplesDoesNotAllocate)
+    {
+        entt::registry registry;
+        SnakeGameplaySystem::reserve(registry, {BOARD_SIZE, BOARD_SIZE});
+        make_scene(registry); // warm-up with one apple: reserve() alone has to make room for the rest
+        for (int i = 0; i < 8; i++)
+            tick(registry);
+        registry.clear();
+
+        const Uint64 allocationCount = AllocationCounter::get_allocation_count();
+        for (int game = 0; game < 4; game++)
+        {
+            registry.clear();
+            SnakeGameplaySystem::reserve(registry, {BOARD_SIZE, BOARD_SIZE});
+            make_scene(registry, BOARD_SIZE);
+            for (int i = 0; i < 32; i++)
+                tick(registry);
+        }
+        EXPECT_EQ(AllocationCounter::get_allocation_count() - allocationCount, 0U);
+        EXPECT_EQ(registry.view<SnakeApple>().size(), static_cast<size_t>(BOARD_SIZE));
+    }
+
+    TEST(AllocationTest, CounterSeesAllocations)
+    {
+        const Uint64 allocationCount = AllocationCounter::get_allocation_count();
+        const Uint64 allocatedBytes = AllocationCounter::get_allocated_bytes();
+        delete new int(1);
+        EXPECT_EQ(AllocationCounter::get_allocation_count() - allocationCount, 1U);
+        EXPECT_EQ(AllocationCounter::get_allocated_bytes() - allocatedBytes, sizeof(int));
+    }
+
+    TEST(AllocationTest, ThreadCounterIgnoresOtherThreads)
+    {
+        const Uint64 allocationCount = AllocationCounter::get_allocation_count();
+        std::thread other([] { int *volatile ptr = new int(1); delete ptr; }); // volatile: new and delete MAY be elided
+        const Uint64 threadAllocationCount = AllocationCounter::get_thread_allocation_count(); // after the std::thread state
+        other.join();
+        EXPECT_GE(AllocationCounter::get_allocation_count() - allocationCount, 2U);
+        EXPECT_EQ(AllocationCounter::get_thread_allocation_count() - threadAllocationCount, 0U);
+
+        const Uint64 threadAllocatedBytes = AllocationCounter::get_thread_allocated_bytes();
+        int *volatile ptr = new int(1);
+        delete ptr;
+        EXPECT_EQ(AllocationCounter::get_thread_allocated_bytes() - threadAllocatedBytes, sizeof(int));
+    }
+} // namespace
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <component/delta_time.hpp>
+#include <component/key_control.hpp>
+#include <render/board_snapshot.hpp>
+
+namespace
+{
+    TEST(BoardSnapshotTest, CaptureMatchesMap)
+    {
+        entt::registry registry;
+        {
+            auto entity = registry.create();
+            registry.emplace<KeyControl>(entity, 'd');
+            registry.emplace<DeltaTime>(entity, 100U);
+            registry.emplace<SnakeBoundary2D>(entity, 4, 2);
+        }
+        {
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 3.5f, 1.5f);
+            registry.emplace<SnakeApple>(entity);
+        }
+        {
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 0.5f, 0.5f);
+            registry.emplace<SnakePart>(entity, 'd');
+        }
+        {
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 1.5f, 0.5f);
+            registry.emplace<Velocity>(entity, 10.0f, 0.0f);
+            registry.emplace<SnakePartHead>(entity, 10.0f, 1.0f);
+        }
+
+        BoardSnapshot snapshot;
+        snapshot.capture(registry);
+        ASSERT_EQ(snapshot.width, 4);
+        ASSERT_EQ(snapshot.height, 2);
+        const SnakeGameplaySystem::Map map = SnakeGameplaySystem::get_map(registry);
+        for (int i = 0; i < snapshot.height; i++)
+            for (int j = 0; j < snapshot.width; j++)
+                EXPECT_EQ(snapshot.board[i * snapshot.width + j], map[i][j]) << i << ", " << j;
+        EXPECT_EQ(snapshot.board[0 * 4 + 3], SnakeGameplaySystem::APPLE);
+        EXPECT_EQ(snapshot.headCell, 1 * 4 + 1);
+        EXPECT_EQ(snapshot.headVelocity.x, 10.0f);
+        EXPECT_EQ(snapshot.score, 1UL);
+        EXPECT_EQ(snapshot.status, BoardSnapshot::PLAYING);
+        EXPECT_EQ(snapshot.entityCounts.position, 3U);
+        EXPECT_EQ(snapshot.entityCounts.apple, 1U);
+
+        BoardSnapshot other = snapshot;
+        EXPECT_TRUE(other.is_same_view(snapshot));
+        other.headVelocity.x = 0.0f; // not drawn
+        EXPECT_TRUE(other.is_same_view(snapshot));
+        other.isPaused = true;
+        EXPECT_FALSE(other.is_same_view(snapshot));
+        EXPECT_TRUE(other.is_idle());
+        other.isPaused = false;
+        other.board[other.headCell] = SnakeGameplaySystem::EMPTY;
+        EXPECT_FALSE(other.is_same_view(snapshot));
+    }
+} // namespace
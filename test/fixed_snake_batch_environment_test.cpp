@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <environment/fixed_snake_batch_environment.hpp>
+#include <environment/snake_batch_environment.hpp>
+
+namespace
+{
+    static_assert(FixedSnakeBatchEnvironment<5, 3>::NEIGHBOURS[0][SnakeEnvironment::UP] == FixedSnakeBoard::WALL, "");
+    static_assert(FixedSnakeBatchEnvironment<5, 3>::NEIGHBOURS[0][SnakeEnvironment::RIGHT] == 1, "");
+    static_assert(FixedSnakeBatchEnvironment<5, 3>::NEIGHBOURS[0][SnakeEnvironment::DOWN] == 5, "");
+    static_assert(FixedSnakeBatchEnvironment<5, 3>::NEIGHBOURS[14][SnakeEnvironment::RIGHT] == FixedSnakeBoard::WALL, "");
+    static_assert(FixedSnakeBatchEnvironment<5, 3>::NEIGHBOURS[14][SnakeEnvironment::DOWN] == FixedSnakeBoard::WALL, "");
+
+    TEST(FixedSnakeBatchEnvironmentTest, NeighboursStayOnTheBoard)
+    {
+        using Batch = FixedSnakeBatchEnvironment<20, 20>;
+        for (Sint32 cell = 0; cell < Batch::CELL_COUNT; cell++)
+        {
+            EXPECT_EQ(Batch::NEIGHBOURS[cell][SnakeEnvironment::NONE], cell);
+            for (int action = SnakeEnvironment::UP; action <= SnakeEnvironment::RIGHT; action++)
+            {
+                const Sint16 next = Batch::NEIGHBOURS[cell][action];
+                if (next == FixedSnakeBoard::WALL)
+                    continue;
+                ASSERT_GE(next, 0);
+                ASSERT_LT(next, Batch::CELL_COUNT);
+                EXPECT_EQ(Batch::NEIGHBOURS[next][FixedSnakeBoard::OPPOSITES[action]], cell);
+            }
+        }
+    }
+
+    template <int Width, int Height>
+    void expect_same_games(const size_t &gameCount, const Uint64 &seed, const int &stepCount)
+    {
+        SnakeBatchEnvironment batch(gameCount, {Width, Height});
+        FixedSnakeBatchEnvironment<Width, Height> fixedBatch(gameCount);
+        batch.reset(seed);
+        fixedBatch.reset(seed);
+        ASSERT_EQ(fixedBatch.get_observation_size(), batch.get_observation_size());
+
+        std::vector<SnakeEnvironment::Action> actions(gameCount);
+        std::vector<float> rewards(gameCount), fixedRewards(gameCount);
+        std::vector<Uint8> dones(gameCount), fixedDones(gameCount);
+        std::vector<Uint8> obs(batch.get_observation_size()), fixedObs(batch.get_observation_size());
+        std::vector<Uint8> board(Width * Height), fixedBoard(Width * Height);
+        Uint64 policyState = seed;
+        for (int step = 0; step < stepCount; step++)
+        {
+            for (size_t g = 0; g < gameCount; g++)
+                actions[g] = static_cast<SnakeEnvironment::Action>(SDL_rand_r(&policyState, SnakeEnvironment::ACTION_END));
+            batch.step(actions.data(), rewards.data(), dones.data());
+            fixedBatch.step(actions.data(), fixedRewards.data(), fixedDones.data());
+            ASSERT_EQ(fixedRewards, rewards) << "step " << step;
+            ASSERT_EQ(fixedDones, dones) << "step " << step;
+
+            batch.observe(obs.data());
+            fixedBatch.observe(fixedObs.data());
+            ASSERT_EQ(fixedObs, obs) << "step " << step;
+            for (size_t g = 0; g < gameCount; g++)
+            {
+                ASSERT_EQ(fixedBatch.get_score(g), batch.get_score(g));
+                batch.export_board(g, board.data());
+                fixedBatch.export_board(g, fixedBoard.data());
+                ASSERT_EQ(fixedBoard, board);
+            }
+        }
+    }
+
+    TEST(FixedSnakeBatchEnvironmentTest, MatchesRuntimeBatch)
+    {
+        expect_same_games<5, 3>(8U, 3U, 2000);
+        expect_same_games<20, 20>(4U, 7U, 2000);
+    }
+} // namespace
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <render/frame_encoder.hpp>
+
+#if defined(__unix__) || defined(__APPLE__) // mkdtemp()
+#include <unistd.h>
+
+namespace
+{
+    std::vector<Uint8> read_file(const std::string &path)
+    {
+        std::vector<Uint8> ret;
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+            return ret;
+        int c;
+        while ((c = std::fgetc(file)) != EOF)
+            ret.push_back(static_cast<Uint8>(c));
+        std::fclose(file);
+        return ret;
+    }
+
+    class FrameEncoderTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            char pattern[] = "/tmp/frame_encoder_test_XXXXXX";
+            ASSERT_NE(mkdtemp(pattern), nullptr);
+            directory = pattern;
+        }
+        void TearDown() override
+        {
+            for (const auto &path : writtenPaths)
+                std::remove(path.c_str());
+            rmdir(directory.c_str());
+        }
+        std::string get_path(const int &index, const char *extension)
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%06d.%s", index, extension);
+            writtenPaths.push_back(directory + name);
+            return writtenPaths.back();
+        }
+
+        std::string directory;
+        std::vector<std::string> writtenPaths;
+    }; // class FrameEncoderTest
+
+    TEST_F(FrameEncoderTest, WritesPpmAndRaw)
+    {
+        // 3x2 XRGB8888 rows padded to a 16-byte pitch
+        const Uint32 pixels[2][4] = {{0x00FF0000U, 0x0000FF00U, 0x000000FFU, 0xDEADBEEFU},
+                                     {0xFF102030U, 0x00000000U, 0x00FFFFFFU, 0xDEADBEEFU}};
+        const std::vector<Uint8> rgb = {0xFF, 0, 0, 0, 0xFF, 0, 0, 0, 0xFF, 0x10, 0x20, 0x30, 0, 0, 0, 0xFF, 0xFF, 0xFF};
+
+        FrameEncoder::Format format;
+        ASSERT_TRUE(FrameEncoder::parse_format("ppm", &format));
+        ASSERT_TRUE(FrameEncoder::parse_format("raw", &format));
+        EXPECT_FALSE(FrameEncoder::parse_format("gif", &format));
+
+        for (const auto &testFormat : {FrameEncoder::PPM, FrameEncoder::RAW})
+        {
+            FrameEncoder encoder;
+            ASSERT_TRUE(encoder.start(directory, testFormat, 3, 2));
+            EXPECT_FALSE(encoder.start(directory, testFormat, 3, 2));
+            ASSERT_TRUE(encoder.push(pixels, sizeof(pixels[0])));
+            encoder.stop();
+            EXPECT_EQ(encoder.get_encoded_count(), 1U);
+            EXPECT_EQ(encoder.get_failed_count(), 0U);
+
+            std::vector<Uint8> expected = rgb;
+            if (testFormat == FrameEncoder::PPM)
+            {
+                const std::string header = "P6\n3 2\n255\n";
+                expected.insert(expected.begin(), header.begin(), header.end());
+            }
+            EXPECT_EQ(read_file(get_path(0, FrameEncoder::FORMAT_NAMES[testFormat])), expected);
+        }
+    }
+
+    TEST_F(FrameEncoderTest, WritesRunLengthEncoded)
+    {
+        std::vector<Uint32> pixels(300U * 1U, 0x00000000U);
+        pixels[299] = 0x00FFFFFFU;
+        FrameEncoder encoder;
+        ASSERT_TRUE(encoder.start(directory, FrameEncoder::RLE, 300, 1));
+        ASSERT_TRUE(encoder.push(pixels.data(), 300 * 4));
+        encoder.stop();
+
+        const std::vector<Uint8> expected = {'S', 'R', 'L', 'E', 44, 1, 0, 0, 1, 0, 0, 0,
+                                             255, 0, 0, 0, 44, 0, 0, 0, 1, 0xFF, 0xFF, 0xFF};
+        EXPECT_EQ(read_file(get_path(0, "rle")), expected);
+    }
+
+    TEST_F(FrameEncoderTest, DropsInsteadOfBlocking)
+    {
+        static constexpr int FRAME_COUNT = 200;
+        std::vector<Uint32> pixels(64U * 64U, 0x00123456U);
+        FrameEncoder encoder;
+        ASSERT_TRUE(encoder.start(directory, FrameEncoder::RAW, 64, 64, 2U));
+        int pushedCount = 0;
+        for (int i = 0; i < FRAME_COUNT; i++)
+            pushedCount += encoder.push(pixels.data(), 64 * 4) ? 1 : 0;
+        encoder.stop();
+
+        EXPECT_EQ(encoder.get_encoded_count(), static_cast<Uint64>(pushedCount));
+        EXPECT_EQ(encoder.get_encoded_count() + encoder.get_dropped_count(), static_cast<Uint64>(FRAME_COUNT));
+        for (int i = 0; i < pushedCount; i++)
+            EXPECT_EQ(read_file(get_path(i, "raw")).size(), 64U * 64U * 3U);
+    }
+} // namespace
+#endif // defined(__unix__) || defined(__APPLE__)
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include <profiler/frame_stats.hpp>
+
+namespace
+{
+    TEST(FrameStatsTest, PublishesOncePerWindow)
+    {
+        FrameStats stats(1000U);
+        for (Uint64 i = 1U; i <= 100U; i++)
+            stats.add_tick(i * 1000U, 16U);
+        for (int i = 0; i < 30; i++)
+            stats.add_frame();
+        stats.add_iterate(1U);
+        stats.add_iterate(4U);
+        stats.add_iterate(2U);
+
+        EXPECT_FALSE(stats.update(1000U + FrameStats::WINDOW_NS - 1U));
+        EXPECT_EQ(stats.get_snapshot().ticksPerSecond, 0.0);
+
+        ASSERT_TRUE(stats.update(1000U + FrameStats::WINDOW_NS));
+        const FrameStats::Snapshot &snapshot = stats.get_snapshot();
+        EXPECT_DOUBLE_EQ(snapshot.ticksPerSecond, 100.0);
+        EXPECT_DOUBLE_EQ(snapshot.framesPerSecond, 30.0);
+        EXPECT_EQ(snapshot.tickP99Ns, 99000U);
+        EXPECT_EQ(snapshot.tickMaxNs, 100000U);
+        EXPECT_EQ(snapshot.catchUpTicksMax, 4U);
+        EXPECT_EQ(snapshot.allocatedBytesPerTick, 16U);
+    }
+
+    TEST(FrameStatsTest, EmptyWindow)
+    {
+        FrameStats stats(0U);
+        stats.add_tick(5U, 0U);
+        ASSERT_TRUE(stats.update(FrameStats::WINDOW_NS));
+        EXPECT_EQ(stats.get_snapshot().tickP99Ns, 5U);
+
+        ASSERT_TRUE(stats.update(3U * FrameStats::WINDOW_NS));
+        EXPECT_DOUBLE_EQ(stats.get_snapshot().ticksPerSecond, 0.0);
+        EXPECT_EQ(stats.get_snapshot().tickP99Ns, 0U);
+        EXPECT_EQ(stats.get_snapshot().catchUpTicksMax, 0U);
+    }
+} // namespace
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <profiler/input_latency_tracker.hpp>
+
+namespace
+{
+    constexpr Uint64 MS = 1000000U;
+
+    TEST(InputLatencyTrackerTest, FollowsTurnThroughEveryStage)
+    {
+        InputLatencyTracker tracker;
+        tracker.on_present(1U * MS); // nothing pending
+        tracker.on_key_down(10U * MS, 2.0f, 0.0f);
+        tracker.on_key_control(11U * MS);
+        tracker.on_tick(2.0f, 0.0f, 5L, 20U * MS); // turn not applied yet
+        tracker.on_tick(0.0f, 2.0f, 5L, 30U * MS);
+        tracker.on_frame(5L, 31U * MS); // head still in the cell where it turned
+        tracker.on_present(32U * MS);
+        tracker.on_tick(0.0f, 2.0f, 25L, 40U * MS);
+        tracker.on_frame(25L, 41U * MS);
+        tracker.on_present(45U * MS);
+        tracker.on_present(50U * MS); // already complete
+
+        const Uint64 expectedNs[InputLatencyTracker::STAGE_END] = {1U * MS, 20U * MS, 31U * MS, 35U * MS};
+        for (int stage = 0; stage < InputLatencyTracker::STAGE_END; stage++)
+        {
+            const InputLatencyTracker::Summary summary = tracker.get_summary(static_cast<InputLatencyTracker::Stage>(stage));
+            EXPECT_EQ(summary.count, 1U);
+            EXPECT_EQ(summary.p50Ns, expectedNs[stage]);
+            EXPECT_EQ(summary.maxNs, expectedNs[stage]);
+        }
+        EXPECT_EQ(tracker.get_abandoned_count(), 0U);
+    }
+
+    TEST(InputLatencyTrackerTest, AbandonsKeysThatNeverTurn)
+    {
+        InputLatencyTracker tracker;
+        tracker.on_key_down(0U, 2.0f, 0.0f);
+        tracker.on_key_control(1U * MS);
+        tracker.on_key_down(5U * MS, 2.0f, 0.0f); // replaces the first key
+        tracker.on_key_control(6U * MS);
+        tracker.on_tick(2.0f, 0.0f, 0L, 5U * MS + InputLatencyTracker::TIMEOUT_NS + 1U);
+        tracker.on_tick(0.0f, 2.0f, 0L, 5U * MS + InputLatencyTracker::TIMEOUT_NS + 2U); // too late
+
+        EXPECT_EQ(tracker.get_abandoned_count(), 2U);
+        EXPECT_EQ(tracker.get_summary(InputLatencyTracker::KEY_CONTROL).count, 2U);
+        EXPECT_EQ(tracker.get_summary(InputLatencyTracker::VELOCITY).count, 0U);
+    }
+
+    TEST(InputLatencyTrackerTest, Percentiles)
+    {
+        InputLatencyTracker tracker;
+        for (Uint64 k = 1U; k <= 100U; k++)
+        {
+            tracker.on_key_down(0U, 0.0f, 0.0f);
+            tracker.on_key_control(k * MS);
+        }
+        const InputLatencyTracker::Summary summary = tracker.get_summary(InputLatencyTracker::KEY_CONTROL);
+        EXPECT_EQ(summary.count, 100U);
+        EXPECT_EQ(summary.p50Ns, 50U * MS);
+        EXPECT_EQ(summary.p90Ns, 90U * MS);
+        EXPECT_EQ(summary.p99Ns, 99U * MS);
+        EXPECT_EQ(summary.maxNs, 100U * MS);
+        EXPECT_EQ(tracker.get_abandoned_count(), 99U); // the last key is still pending
+    }
+} // namespace
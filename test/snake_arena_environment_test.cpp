@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <environment/snake_arena_environment.hpp>
+
+namespace
+{
+    // Sum of the live snakes' lengths must match the occupancy index.
+    void expect_consistent(const SnakeArenaEnvironment &arena, const Sint32 &cellCount)
+    {
+        Sint32 lengthSum = 0;
+        for (size_t s = 0; s < arena.get_snake_count(); s++)
+        {
+            if (!arena.is_alive(s))
+            {
+                EXPECT_EQ(arena.get_length(s), 0);
+                continue;
+            }
+            lengthSum += arena.get_length(s);
+            EXPECT_EQ(arena.get_owner(arena.get_head_cell(s)), static_cast<Sint32>(s));
+        }
+        Sint32 ownedCount = 0;
+        for (Sint32 cell = 0; cell < cellCount; cell++)
+            ownedCount += arena.get_owner(cell) >= 0;
+        EXPECT_EQ(ownedCount, lengthSum);
+        EXPECT_EQ(arena.get_occupied_count(), lengthSum);
+        if (arena.get_apple_cell() >= 0)
+        {
+            EXPECT_EQ(arena.get_owner(arena.get_apple_cell()), -1);
+        }
+    }
+
+    TEST(SnakeArenaEnvironmentTest, RandomMatchesStayConsistent)
+    {
+        constexpr int WIDTH = 24;
+        constexpr int HEIGHT = 16;
+        SnakeArenaEnvironment arena({WIDTH, HEIGHT, 64U});
+        std::vector<SnakeEnvironment::Action> actions(64U);
+        std::vector<float> rewards(64U);
+        std::vector<Uint8> dones(64U);
+        Uint64 policyState = 5U;
+        int matchCount = 0;
+        for (int step = 0; step < 5000; step++)
+        {
+            for (SnakeEnvironment::Action &action : actions)
+                action = static_cast<SnakeEnvironment::Action>(SDL_rand_r(&policyState, SnakeEnvironment::ACTION_END));
+            arena.step(actions.data(), rewards.data(), dones.data());
+            expect_consistent(arena, WIDTH * HEIGHT);
+            for (size_t s = 0; s < 64U; s++)
+                EXPECT_EQ(dones[s] != 0U, !arena.is_alive(s));
+            if (arena.is_over())
+            {
+                EXPECT_LE(arena.get_alive_count(), 1U);
+                arena.reset(static_cast<Uint64>(step));
+                matchCount++;
+            }
+        }
+        EXPECT_GT(matchCount, 0);
+    }
+
+    TEST(SnakeArenaEnvironmentTest, SameSeedSameMatch)
+    {
+        SnakeArenaEnvironment first({16, 16, 8U});
+        SnakeArenaEnvironment second({16, 16, 8U});
+        first.reset(3U);
+        second.reset(3U);
+        std::vector<SnakeEnvironment::Action> actions(8U, SnakeEnvironment::NONE);
+        std::vector<float> rewards(8U), otherRewards(8U);
+        std::vector<Uint8> dones(8U), otherDones(8U);
+        std::vector<Uint8> board(256U), otherBoard(256U);
+        for (int step = 0; step < 20 && !first.is_over(); step++)
+        {
+            first.step(actions.data(), rewards.data(), dones.data());
+            second.step(actions.data(), otherRewards.data(), otherDones.data());
+            first.export_board(board.data());
+            second.export_board(otherBoard.data());
+            ASSERT_EQ(board, otherBoard);
+            ASSERT_EQ(rewards, otherRewards);
+        }
+    }
+
+    TEST(SnakeArenaEnvironmentTest, HeadToHeadKillsBoth)
+    { // wherever the apple is, both heads claim cell 2
+        SnakeArenaEnvironment arena({5, 1, 2U});
+        const SnakeArenaEnvironment::Spawn spawns[2] = {{1, SnakeEnvironment::RIGHT}, {3, SnakeEnvironment::LEFT}};
+        arena.reset(1U, spawns);
+        const SnakeEnvironment::Action actions[2] = {SnakeEnvironment::NONE, SnakeEnvironment::NONE};
+        float rewards[2];
+        Uint8 dones[2];
+        arena.step(actions, rewards, dones);
+        EXPECT_EQ(dones[0], 1U);
+        EXPECT_EQ(dones[1], 1U);
+        EXPECT_FLOAT_EQ(rewards[0], SnakeEnvironment::FAILURE_REWARD);
+        EXPECT_FLOAT_EQ(rewards[1], SnakeEnvironment::FAILURE_REWARD);
+        EXPECT_TRUE(arena.is_over());
+        EXPECT_EQ(arena.get_occupied_count(), 0);
+    }
+
+    TEST(SnakeArenaEnvironmentTest, HeadsSwappingKillsBoth)
+    {
+        SnakeArenaEnvironment arena({4, 1, 2U});
+        const SnakeArenaEnvironment::Spawn spawns[2] = {{1, SnakeEnvironment::RIGHT}, {2, SnakeEnvironment::LEFT}};
+        arena.reset(1U, spawns);
+        const SnakeEnvironment::Action actions[2] = {SnakeEnvironment::NONE, SnakeEnvironment::NONE};
+        float rewards[2];
+        Uint8 dones[2];
+        arena.step(actions, rewards, dones);
+        EXPECT_EQ(dones[0], 1U);
+        EXPECT_EQ(dones[1], 1U);
+        EXPECT_TRUE(arena.is_over());
+    }
+
+    TEST(SnakeArenaEnvironmentTest, FollowingATailIsAllowed)
+    { // snake 1 moves into the cell snake 0 leaves in the same step
+        SnakeArenaEnvironment arena({4, 2, 2U});
+        const SnakeArenaEnvironment::Spawn spawns[2] = {{1, SnakeEnvironment::DOWN}, {0, SnakeEnvironment::RIGHT}};
+        arena.reset(1U, spawns);
+        const SnakeEnvironment::Action actions[2] = {SnakeEnvironment::NONE, SnakeEnvironment::NONE};
+        float rewards[2];
+        Uint8 dones[2];
+        arena.step(actions, rewards, dones);
+        if (arena.get_length(0) == 1) // snake 0 did not grow from an apple at cell 5
+        {
+            EXPECT_EQ(dones[1], 0U);
+            EXPECT_EQ(arena.get_owner(1), 1);
+            EXPECT_EQ(arena.get_owner(5), 0);
+        }
+        else
+            EXPECT_EQ(dones[1], 1U); // its tail stayed put
+        EXPECT_EQ(dones[0], 0U);
+    }
+
+    TEST(SnakeArenaEnvironmentTest, HeadIntoBodyKillsOnlyTheMover)
+    { // 2 x 2 board whose only free cell, 1, holds the apple: snake 0 eats it and
+      // keeps its tail on cell 0, where snake 1 moves in
+        SnakeArenaEnvironment arena({2, 2, 3U});
+        const SnakeArenaEnvironment::Spawn spawns[3] = {
+            {0, SnakeEnvironment::RIGHT}, {2, SnakeEnvironment::UP}, {3, SnakeEnvironment::LEFT}};
+        arena.reset(1U, spawns);
+        ASSERT_EQ(arena.get_apple_cell(), 1);
+        const SnakeEnvironment::Action actions[3] = {SnakeEnvironment::NONE, SnakeEnvironment::NONE, SnakeEnvironment::NONE};
+        float rewards[3];
+        Uint8 dones[3];
+        arena.step(actions, rewards, dones);
+        EXPECT_EQ(dones[0], 0U);
+        EXPECT_EQ(dones[1], 1U);
+        EXPECT_EQ(dones[2], 0U);
+        EXPECT_FLOAT_EQ(rewards[0], SnakeEnvironment::APPLE_REWARD);
+        EXPECT_FLOAT_EQ(rewards[1], SnakeEnvironment::FAILURE_REWARD);
+        EXPECT_EQ(arena.get_length(0), 2);
+        EXPECT_EQ(arena.get_owner(0), 0);
+        EXPECT_EQ(arena.get_owner(2), 2);
+        EXPECT_EQ(arena.get_apple_cell(), 3);
+        EXPECT_FALSE(arena.is_over());
+        expect_consistent(arena, 4);
+    }
+} // namespace
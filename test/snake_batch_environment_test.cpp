@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <environment/snake_batch_environment.hpp>
+#include <environment/snake_environment.hpp>
+#include <system/snake_hamiltonian_solver.hpp>
+
+namespace
+{
+    TEST(SnakeBatchEnvironmentTest, MatchesSingleEnvironment)
+    {
+        SnakeEnvironment env({5, 3});
+        env.reset(1U);
+        SnakeBatchEnvironment batch(2U, {5, 3});
+        batch.reset(1U);
+
+        const SnakeEnvironment::Action actions[] = {SnakeEnvironment::RIGHT, SnakeEnvironment::NONE, SnakeEnvironment::UP,
+                                                    SnakeEnvironment::RIGHT, SnakeEnvironment::LEFT, SnakeEnvironment::DOWN};
+        std::vector<Uint8> obs(env.get_observation_size());
+        std::vector<Uint8> batchObs(batch.get_observation_size());
+        for (const SnakeEnvironment::Action &action : actions)
+        { // no apple is eaten on this path, so both apples stay put
+            const SnakeEnvironment::StepResult result = env.step(action);
+            const SnakeEnvironment::Action batchActions[2] = {action, action};
+            float rewards[2];
+            Uint8 dones[2];
+            batch.step(batchActions, rewards, dones);
+
+            env.observe(obs.data());
+            batch.observe(batchObs.data());
+            for (size_t g = 0; g < 2; g++)
+            {
+                EXPECT_FLOAT_EQ(rewards[g], result.reward);
+                EXPECT_EQ(dones[g] != 0U, result.done);
+                EXPECT_TRUE(std::equal(obs.begin(), obs.end(), batchObs.begin() + g * obs.size()));
+            }
+        }
+    }
+
+    TEST(SnakeBatchEnvironmentTest, AutoResetOnWall)
+    {
+        SnakeBatchEnvironment batch(3U, {5, 3});
+        std::vector<Uint8> initialObs(batch.get_observation_size());
+        batch.observe(initialObs.data());
+
+        const SnakeEnvironment::Action actions[3] = {SnakeEnvironment::UP, SnakeEnvironment::DOWN, SnakeEnvironment::RIGHT};
+        float rewards[3];
+        Uint8 dones[3];
+        batch.step(actions, rewards, dones);
+        for (size_t g = 0; g < 3; g++)
+            EXPECT_EQ(dones[g], 0U);
+
+        batch.step(actions, rewards, dones);
+        EXPECT_EQ(dones[0], 1U);
+        EXPECT_EQ(dones[1], 1U);
+        EXPECT_EQ(dones[2], 0U);
+        EXPECT_FLOAT_EQ(rewards[0], SnakeEnvironment::FAILURE_REWARD);
+        EXPECT_FLOAT_EQ(rewards[1], SnakeEnvironment::FAILURE_REWARD);
+
+        std::vector<Uint8> obs(batch.get_observation_size());
+        batch.observe(obs.data());
+        const size_t gameSize = obs.size() / 3U;
+        EXPECT_TRUE(std::equal(obs.begin(), obs.begin() + 2U * gameSize, initialObs.begin()));
+    }
+
+    TEST(SnakeBatchEnvironmentTest, FullBoardAlongCycle)
+    {
+        const SnakeBoundary2D boundary = {4, 4};
+        const SnakeHamiltonianSolver::Cycle *cycle = SnakeHamiltonianSolver::get_cycle(boundary);
+        ASSERT_NE(cycle, nullptr);
+
+        const size_t gameCount = 8U;
+        SnakeBatchEnvironment batch(gameCount, {boundary.x, boundary.y});
+        batch.reset(42U);
+        std::vector<SnakeEnvironment::Action> actions(gameCount);
+        std::vector<float> rewards(gameCount);
+        std::vector<Uint8> dones(gameCount);
+        std::vector<bool> isFinished(gameCount, false);
+
+        long cell = (boundary.y / 2) * boundary.x; // starting cell of every game
+        for (int i = 0; i < 16 * 16; i++)
+        {
+            const long nextCell = cycle->cells[(cycle->order[cell] + 1) % cycle->cells.size()];
+            SnakeEnvironment::Action action = SnakeEnvironment::NONE;
+            if (nextCell == cell - boundary.x)
+                action = SnakeEnvironment::UP;
+            else if (nextCell == cell + boundary.x)
+                action = SnakeEnvironment::DOWN;
+            else if (nextCell == cell - 1)
+                action = SnakeEnvironment::LEFT;
+            else
+                action = SnakeEnvironment::RIGHT;
+            std::fill(actions.begin(), actions.end(), action);
+            batch.step(actions.data(), rewards.data(), dones.data());
+            cell = nextCell;
+
+            for (size_t g = 0; g < gameCount; g++)
+            {
+                if (dones[g] && !isFinished[g]) // games that were reset are no longer on the cycle
+                {
+                    EXPECT_GT(rewards[g], SnakeEnvironment::SUCCESS_REWARD);
+                    EXPECT_EQ(batch.get_score(g), 0UL);
+                    isFinished[g] = true;
+                }
+            }
+        }
+        for (size_t g = 0; g < gameCount; g++)
+            EXPECT_TRUE(isFinished[g]);
+    }
+} // namespace
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <snake.h>
+
+namespace
+{
+    snake_config make_config(const int32_t &width, const int32_t &height)
+    {
+        snake_config config;
+        snake_config_init(&config);
+        config.width = width;
+        config.height = height;
+        return config;
+    }
+
+    TEST(SnakeCApiTest, InvalidArguments)
+    {
+        EXPECT_EQ(snake_get_abi_version(), SNAKE_ABI_VERSION);
+
+        snake_game *game = reinterpret_cast<snake_game *>(1);
+        snake_config config = make_config(1, 3);
+        EXPECT_EQ(snake_game_create(&config, 1U, &game), SNAKE_ERROR_INVALID_ARGUMENT);
+        EXPECT_EQ(game, nullptr);
+        EXPECT_EQ(snake_game_create(nullptr, 1U, &game), SNAKE_ERROR_INVALID_ARGUMENT);
+        EXPECT_EQ(snake_game_step(nullptr, SNAKE_ACTION_NONE, nullptr, nullptr), SNAKE_ERROR_INVALID_ARGUMENT);
+        EXPECT_EQ(snake_game_get_board_size(nullptr), 0U);
+        snake_game_destroy(nullptr);
+
+        config = make_config(5, 3);
+        ASSERT_EQ(snake_game_create(&config, 1U, &game), SNAKE_OK);
+        std::vector<uint8_t> board(snake_game_get_board_size(game) - 1U);
+        EXPECT_EQ(snake_game_export_board(game, board.data(), board.size()), SNAKE_ERROR_BUFFER_TOO_SMALL);
+        EXPECT_EQ(snake_game_step(game, static_cast<snake_action>(7), nullptr, nullptr), SNAKE_ERROR_INVALID_ARGUMENT);
+        snake_game_destroy(game);
+
+        snake_batch *batch = nullptr;
+        EXPECT_EQ(snake_batch_create(0U, &config, 1U, &batch), SNAKE_ERROR_INVALID_ARGUMENT);
+        EXPECT_EQ(batch, nullptr);
+    }
+
+    TEST(SnakeCApiTest, GameStepScoreAndBoard)
+    {
+        snake_config config = make_config(5, 3);
+        snake_game *game = nullptr;
+        ASSERT_EQ(snake_game_create(&config, 1U, &game), SNAKE_OK);
+        ASSERT_EQ(snake_game_get_board_size(game), 15U);
+
+        // . . . . .
+        // $ . . . @
+        // . . . . .
+        std::vector<uint8_t> board(snake_game_get_board_size(game));
+        ASSERT_EQ(snake_game_export_board(game, board.data(), board.size()), SNAKE_OK);
+        for (size_t i = 0; i < board.size(); i++)
+            EXPECT_EQ(board[i], i == 5U ? SNAKE_CELL_HEAD : (i == 9U ? SNAKE_CELL_APPLE : SNAKE_CELL_EMPTY));
+
+        float reward = 0.0f;
+        int done = 1;
+        for (int i = 0; i < 4; i++)
+            ASSERT_EQ(snake_game_step(game, SNAKE_ACTION_RIGHT, &reward, &done), SNAKE_OK);
+        EXPECT_FLOAT_EQ(reward, 1.0f);
+        EXPECT_EQ(done, 0);
+        uint64_t score = 0U;
+        ASSERT_EQ(snake_game_get_score(game, &score), SNAKE_OK);
+        EXPECT_EQ(score, 1U);
+
+        ASSERT_EQ(snake_game_export_board(game, board.data(), board.size()), SNAKE_OK);
+        EXPECT_EQ(board[9], SNAKE_CELL_HEAD);
+        EXPECT_EQ(board[8], SNAKE_CELL_BODY);
+
+        snake_status status = SNAKE_STATUS_SUCCESS;
+        ASSERT_EQ(snake_game_get_status(game, &status), SNAKE_OK);
+        EXPECT_EQ(status, SNAKE_STATUS_RUNNING);
+        ASSERT_EQ(snake_game_step(game, SNAKE_ACTION_NONE, &reward, &done), SNAKE_OK); // into the wall
+        EXPECT_EQ(done, 1);
+        ASSERT_EQ(snake_game_get_status(game, &status), SNAKE_OK);
+        EXPECT_EQ(status, SNAKE_STATUS_FAILURE);
+
+        ASSERT_EQ(snake_game_reset(game, 1U), SNAKE_OK);
+        ASSERT_EQ(snake_game_get_status(game, &status), SNAKE_OK);
+        EXPECT_EQ(status, SNAKE_STATUS_RUNNING);
+        snake_game_destroy(game);
+    }
+
+    TEST(SnakeCApiTest, GameSnakes)
+    {
+        snake_config config = make_config(5, 3);
+        snake_game *game = nullptr;
+        config.snake_count = 0;
+        EXPECT_EQ(snake_game_create(&config, 1U, &game), SNAKE_ERROR_INVALID_ARGUMENT);
+        config.snake_count = 4; // one row each
+        EXPECT_EQ(snake_game_create(&config, 1U, &game), SNAKE_ERROR_INVALID_ARGUMENT);
+        config.snake_count = 2;
+        snake_batch *batch = nullptr;
+        EXPECT_EQ(snake_batch_create(2U, &config, 1U, &batch), SNAKE_ERROR_INVALID_ARGUMENT);
+        ASSERT_EQ(snake_game_create(&config, 1U, &game), SNAKE_OK);
+        ASSERT_EQ(snake_game_get_snake_count(game), 2U);
+
+        uint8_t actions[2] = {SNAKE_ACTION_RIGHT, 9U};
+        float rewards[2] = {0.0f, 0.0f};
+        uint8_t dones[2] = {1U, 1U};
+        EXPECT_EQ(snake_game_step_snakes(game, actions, rewards, dones), SNAKE_ERROR_INVALID_ARGUMENT);
+
+        // . . . . .
+        // $ . . . @
+        // $ . . . @
+        actions[1] = SNAKE_ACTION_RIGHT;
+        for (int i = 0; i < 4; i++)
+            ASSERT_EQ(snake_game_step_snakes(game, actions, rewards, dones), SNAKE_OK);
+        EXPECT_FLOAT_EQ(rewards[0], 1.0f);
+        EXPECT_FLOAT_EQ(rewards[1], 1.0f);
+        uint64_t score = 0U;
+        ASSERT_EQ(snake_game_get_snake_score(game, 0U, &score), SNAKE_OK);
+        EXPECT_EQ(score, 1U);
+        ASSERT_EQ(snake_game_get_snake_score(game, 1U, &score), SNAKE_OK);
+        EXPECT_EQ(score, 1U);
+        EXPECT_EQ(snake_game_get_snake_score(game, 2U, &score), SNAKE_ERROR_INVALID_ARGUMENT);
+        actions[0] = SNAKE_ACTION_UP;
+        actions[1] = SNAKE_ACTION_DOWN; // off the bottom
+        ASSERT_EQ(snake_game_step_snakes(game, actions, rewards, dones), SNAKE_OK);
+        EXPECT_EQ(dones[0], 0U);
+        EXPECT_EQ(dones[1], 1U);
+        EXPECT_FLOAT_EQ(rewards[1], -1.0f);
+        snake_game_destroy(game);
+    }
+
+    TEST(SnakeCApiTest, GameLevel)
+    {
+        snake_config config = make_config(5, 3);
+        snake_game *game = nullptr;
+        ASSERT_EQ(snake_game_create(&config, 1U, &game), SNAKE_OK);
+        std::vector<uint8_t> mask(snake_game_get_board_size(game), 1U);
+        EXPECT_EQ(snake_game_load_obstacles(game, mask.data(), mask.size() - 1U), SNAKE_ERROR_BUFFER_TOO_SMALL);
+        EXPECT_EQ(snake_game_load_obstacles(game, mask.data(), mask.size()), SNAKE_ERROR_INVALID_ARGUMENT); // no room to play
+        EXPECT_EQ(snake_game_load_level(game, "......", 6U), SNAKE_ERROR_INVALID_ARGUMENT);
+        EXPECT_EQ(snake_game_load_level(nullptr, "", 0U), SNAKE_ERROR_INVALID_ARGUMENT);
+
+        // . . . . .
+        // $ . # . @
+        // . . . . .
+        ASSERT_EQ(snake_game_load_level(game, "\n..#", 4U), SNAKE_OK);
+        ASSERT_EQ(snake_game_reset(game, 1U), SNAKE_OK);
+        std::vector<uint8_t> board(snake_game_get_board_size(game));
+        ASSERT_EQ(snake_game_export_board(game, board.data(), board.size()), SNAKE_OK);
+        EXPECT_EQ(board[7], SNAKE_CELL_OBSTACLE);
+        EXPECT_EQ(board[5], SNAKE_CELL_HEAD);
+
+        int done = 0;
+        ASSERT_EQ(snake_game_step(game, SNAKE_ACTION_RIGHT, nullptr, &done), SNAKE_OK);
+        EXPECT_EQ(done, 0);
+        ASSERT_EQ(snake_game_step(game, SNAKE_ACTION_RIGHT, nullptr, &done), SNAKE_OK);
+        EXPECT_EQ(done, 1); // into the obstacle
+        snake_status status;
+        ASSERT_EQ(snake_game_get_status(game, &status), SNAKE_OK);
+        EXPECT_EQ(status, SNAKE_STATUS_FAILURE);
+
+        ASSERT_EQ(snake_game_load_level(game, nullptr, 0U), SNAKE_OK);
+        ASSERT_EQ(snake_game_reset(game, 1U), SNAKE_OK);
+        ASSERT_EQ(snake_game_export_board(game, board.data(), board.size()), SNAKE_OK);
+        EXPECT_EQ(board[7], SNAKE_CELL_EMPTY);
+        snake_game_destroy(game);
+    }
+
+    TEST(SnakeCApiTest, BatchStep)
+    {
+        snake_config config = make_config(5, 3);
+        snake_batch *batch = nullptr;
+        ASSERT_EQ(snake_batch_create(4U, &config, 1U, &batch), SNAKE_OK);
+        ASSERT_EQ(snake_batch_get_game_count(batch), 4U);
+        ASSERT_EQ(snake_batch_get_board_size(batch), 15U);
+
+        // game 0 eats the apple, game 1 hits the top wall, the rest send invalid bytes which keep the direction
+        const uint8_t actions[4] = {SNAKE_ACTION_RIGHT, SNAKE_ACTION_UP, 0xFFU, SNAKE_ACTION_NONE};
+        float rewards[4];
+        uint8_t dones[4];
+        for (int i = 0; i < 4; i++)
+        {
+            const uint8_t stepActions[4] = {actions[0], i == 1 ? actions[1] : uint8_t(SNAKE_ACTION_NONE), actions[2], actions[3]};
+            ASSERT_EQ(snake_batch_step(batch, stepActions, rewards, dones), SNAKE_OK);
+        }
+        EXPECT_FLOAT_EQ(rewards[0], 1.0f);
+        EXPECT_EQ(dones[0], 0U);
+
+        uint64_t score = 0U;
+        ASSERT_EQ(snake_batch_get_score(batch, 0U, &score), SNAKE_OK);
+        EXPECT_EQ(score, 1U);
+        ASSERT_EQ(snake_batch_get_score(batch, 1U, &score), SNAKE_OK);
+        EXPECT_EQ(score, 0U);
+        EXPECT_EQ(snake_batch_get_score(batch, 4U, &score), SNAKE_ERROR_INVALID_ARGUMENT);
+
+        std::vector<uint8_t> board(snake_batch_get_board_size(batch));
+        ASSERT_EQ(snake_batch_export_board(batch, 0U, board.data(), board.size()), SNAKE_OK);
+        EXPECT_EQ(board[9], SNAKE_CELL_HEAD);
+        EXPECT_EQ(board[8], SNAKE_CELL_BODY);
+        ASSERT_EQ(snake_batch_export_board(batch, 2U, board.data(), board.size()), SNAKE_OK);
+        EXPECT_EQ(board[9], SNAKE_CELL_HEAD); // on the apple after four cells to the right
+        snake_batch_destroy(batch);
+    }
+
+    TEST(SnakeCApiTest, GamesSteppedAlternatelyAreIndependent)
+    {
+        const snake_config config = make_config(8, 6);
+        auto play = [](snake_game *game, std::vector<std::vector<uint8_t>> &boards)
+        { // chase the apple so that the bodies grow
+            std::vector<uint8_t> board(snake_game_get_board_size(game));
+            ASSERT_EQ(snake_game_export_board(game, board.data(), board.size()), SNAKE_OK);
+            int head = -1, apple = -1;
+            for (int cell = 0; cell < static_cast<int>(board.size()); cell++)
+            {
+                head = (board[cell] & SNAKE_CELL_HEAD) ? cell : head;
+                apple = (board[cell] & SNAKE_CELL_APPLE) ? cell : apple;
+            }
+            snake_action action = SNAKE_ACTION_NONE;
+            if (head >= 0 && apple >= 0 && apple % 8 != head % 8)
+                action = apple % 8 < head % 8 ? SNAKE_ACTION_LEFT : SNAKE_ACTION_RIGHT;
+            else if (head >= 0 && apple >= 0)
+                action = apple / 8 < head / 8 ? SNAKE_ACTION_UP : SNAKE_ACTION_DOWN;
+            int done = 0;
+            ASSERT_EQ(snake_game_step(game, action, nullptr, &done), SNAKE_OK);
+            if (done)
+            {
+                ASSERT_EQ(snake_game_reset(game, 5U), SNAKE_OK);
+            }
+            ASSERT_EQ(snake_game_export_board(game, board.data(), board.size()), SNAKE_OK);
+            boards.push_back(board);
+        };
+
+        std::vector<std::vector<uint8_t>> soloBoards[2], interleavedBoards[2];
+        for (int g = 0; g < 2; g++)
+        {
+            snake_game *game = nullptr;
+            ASSERT_EQ(snake_game_create(&config, 1U + g, &game), SNAKE_OK);
+            for (int step = 0; step < 50; step++)
+                play(game, soloBoards[g]);
+            snake_game_destroy(game);
+        }
+
+        snake_game *games[2] = {nullptr, nullptr};
+        ASSERT_EQ(snake_game_create(&config, 1U, &games[0]), SNAKE_OK);
+        ASSERT_EQ(snake_game_create(&config, 2U, &games[1]), SNAKE_OK);
+        for (int step = 0; step < 50; step++)
+        {
+            for (int g = 0; g < 2; g++)
+                play(games[g], interleavedBoards[g]);
+        }
+        for (int g = 0; g < 2; g++)
+        {
+            EXPECT_EQ(interleavedBoards[g], soloBoards[g]);
+            snake_game_destroy(games[g]);
+        }
+    }
+} // namespace
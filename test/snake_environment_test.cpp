@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <environment/snake_environment.hpp>
+
+namespace
+{
+    TEST(SnakeEnvironmentTest, ResetObservation)
+    {
+        SnakeEnvironment env({5, 3});
+        env.reset(1U);
+        std::vector<Uint8> obs(env.get_observation_size(), 0xFFU);
+        ASSERT_EQ(obs.size(), 5U * 3U * SnakeEnvironment::PLANE_COUNT);
+        env.observe(obs.data());
+
+        // . . . . .
+        // $ . . . @
+        // . . . . .
+        const size_t planeSize = 5U * 3U;
+        for (size_t i = 0; i < obs.size(); i++)
+        {
+            const bool isHead = i == SnakeEnvironment::HEAD_PLANE * planeSize + 1U * 5U + 0U;
+            const bool isApple = i == SnakeEnvironment::APPLE_PLANE * planeSize + 1U * 5U + 4U;
+            EXPECT_EQ(obs[i], (isHead || isApple) ? 1U : 0U);
+        }
+        EXPECT_FALSE(env.is_done());
+    }
+
+    TEST(SnakeEnvironmentTest, LevelMovesTheStartAndBlocksTheHead)
+    {
+        SnakeEnvironment env({5, 3});
+        EXPECT_FALSE(env.load_level("......", 6U)); // wider than the board
+        const char level[] = "\n#...#\n";
+        ASSERT_TRUE(env.load_level(level, sizeof(level) - 1U));
+        env.reset(1U);
+
+        // $ . . . @
+        // # . . . #
+        // . . . . .
+        std::vector<Uint8> obs(env.get_observation_size());
+        env.observe(obs.data());
+        const size_t planeSize = 5U * 3U;
+        for (size_t i = 0; i < obs.size(); i++)
+        {
+            const bool isHead = i == SnakeEnvironment::HEAD_PLANE * planeSize + 0U;
+            const bool isApple = i == SnakeEnvironment::APPLE_PLANE * planeSize + 4U;
+            const bool isObstacle = i == SnakeEnvironment::OBSTACLE_PLANE * planeSize + 1U * 5U + 0U ||
+                                    i == SnakeEnvironment::OBSTACLE_PLANE * planeSize + 1U * 5U + 4U;
+            EXPECT_EQ(obs[i], (isHead || isApple || isObstacle) ? 1U : 0U) << i;
+        }
+        std::vector<Uint8> board(planeSize);
+        env.export_board(board.data());
+        EXPECT_EQ(board[1U * 5U + 0U], SnakeGameplaySystem::OBSTACLE);
+        EXPECT_EQ(board[1U * 5U + 4U], SnakeGameplaySystem::OBSTACLE);
+
+        const SnakeEnvironment::StepResult result = env.step(SnakeEnvironment::DOWN);
+        EXPECT_TRUE(result.done);
+        EXPECT_FALSE(env.is_success());
+
+        env.load_obstacles(nullptr); // open again from the next reset
+        env.reset(1U);
+        env.observe(obs.data());
+        EXPECT_EQ(obs[SnakeEnvironment::HEAD_PLANE * planeSize + 1U * 5U + 0U], 1U);
+        EXPECT_EQ(obs[SnakeEnvironment::OBSTACLE_PLANE * planeSize + 1U * 5U + 0U], 0U);
+        EXPECT_FALSE(env.step(SnakeEnvironment::DOWN).done);
+    }
+
+    TEST(SnakeEnvironmentTest, StepOneCellAndEatApple)
+    {
+        SnakeEnvironment env({5, 3});
+        env.reset(1U);
+        std::vector<Uint8> obs(env.get_observation_size());
+
+        for (int i = 1; i <= 3; i++)
+        {
+            SnakeEnvironment::StepResult result = env.step(SnakeEnvironment::RIGHT);
+            EXPECT_FLOAT_EQ(result.reward, 0.0f);
+            EXPECT_FALSE(result.done);
+            env.observe(obs.data());
+            EXPECT_EQ(obs[SnakeEnvironment::HEAD_PLANE * 15U + 1U * 5U + i], 1U);
+        }
+
+        SnakeEnvironment::StepResult result = env.step(SnakeEnvironment::NONE);
+        EXPECT_FLOAT_EQ(result.reward, SnakeEnvironment::APPLE_REWARD);
+        EXPECT_FALSE(result.done);
+        EXPECT_EQ(env.get_score(), 1UL);
+
+        // . . . x $ ; apple respawned elsewhere
+        env.observe(obs.data());
+        EXPECT_EQ(obs[SnakeEnvironment::HEAD_PLANE * 15U + 1U * 5U + 4U], 1U);
+        EXPECT_EQ(obs[SnakeEnvironment::BODY_PLANE * 15U + 1U * 5U + 3U], 1U);
+        EXPECT_EQ(obs[SnakeEnvironment::APPLE_PLANE * 15U + 1U * 5U + 4U], 0U);
+    }
+
+    TEST(SnakeEnvironmentTest, HitWallIsDone)
+    {
+        SnakeEnvironment env({5, 3});
+        env.reset(1U);
+
+        EXPECT_FALSE(env.step(SnakeEnvironment::UP).done); // row 0
+        SnakeEnvironment::StepResult result = env.step(SnakeEnvironment::UP);
+        EXPECT_TRUE(result.done);
+        EXPECT_FLOAT_EQ(result.reward, SnakeEnvironment::FAILURE_REWARD);
+        EXPECT_TRUE(env.step(SnakeEnvironment::DOWN).done);
+
+        env.reset(2U);
+        EXPECT_FALSE(env.is_done());
+        EXPECT_EQ(env.get_score(), 0UL);
+    }
+
+    TEST(SnakeEnvironmentTest, SnakesStepOnTheirOwn)
+    {
+        SnakeEnvironment::Config config;
+        config.width = 8;
+        config.height = 6;
+        config.snakeCount = 3;
+        SnakeEnvironment env(config);
+        env.reset(1U);
+        ASSERT_EQ(env.get_snake_count(), 3U);
+
+        // one head per row 1, 3 and 4, its apple on the far column
+        std::vector<Uint8> obs(env.get_observation_size());
+        env.observe(obs.data());
+        const size_t planeSize = 8U * 6U;
+        for (size_t cell = 0; cell < planeSize; cell++)
+        {
+            const bool isHead = cell == 1U * 8U || cell == 3U * 8U || cell == 4U * 8U;
+            EXPECT_EQ(obs[SnakeEnvironment::HEAD_PLANE * planeSize + cell], isHead ? 1U : 0U) << cell;
+        }
+
+        const SnakeEnvironment::Action actions[3] = {SnakeEnvironment::UP, SnakeEnvironment::RIGHT, SnakeEnvironment::RIGHT};
+        SnakeEnvironment::StepResult results[3];
+        env.step(actions, results); // row 0
+        for (const SnakeEnvironment::StepResult &result : results)
+            EXPECT_FALSE(result.done);
+        env.step(actions, results); // off the top for the first one
+        EXPECT_TRUE(results[0].done);
+        EXPECT_FLOAT_EQ(results[0].reward, SnakeEnvironment::FAILURE_REWARD);
+        EXPECT_FALSE(results[1].done);
+        EXPECT_FALSE(results[2].done);
+        EXPECT_FALSE(env.is_done());
+
+        env.step(actions, results);
+        EXPECT_TRUE(results[0].done);
+        EXPECT_FLOAT_EQ(results[0].reward, 0.0f);
+        EXPECT_FALSE(env.get_registry().valid(env.get_snake_head(0U)));
+        env.observe(obs.data());
+        for (size_t cell = 0; cell < planeSize; cell++)
+        {
+            const bool isHead = cell == 3U * 8U + 3U || cell == 4U * 8U + 3U;
+            EXPECT_EQ(obs[SnakeEnvironment::HEAD_PLANE * planeSize + cell], isHead ? 1U : 0U) << cell;
+        }
+    }
+
+    // Heads for the apple, so that games grow bodies; a function of the board only.
+    SnakeEnvironment::Action chase_apple(const std::vector<Uint8> &board, const int &width)
+    {
+        int head = -1, apple = -1;
+        for (int cell = 0; cell < static_cast<int>(board.size()); cell++)
+        {
+            if (board[cell] & SnakeGameplaySystem::SNAKE_HEAD)
+                head = cell;
+            if (board[cell] & SnakeGameplaySystem::APPLE)
+                apple = cell;
+        }
+        if (head < 0 || apple < 0)
+            return SnakeEnvironment::NONE;
+        if (apple % width != head % width)
+            return apple % width < head % width ? SnakeEnvironment::LEFT : SnakeEnvironment::RIGHT;
+        return apple / width < head / width ? SnakeEnvironment::UP : SnakeEnvironment::DOWN;
+    }
+
+    TEST(SnakeEnvironmentTest, InterleavedInstancesMatchSoloRuns)
+    {
+        constexpr int STEP_COUNT = 60;
+        unsigned long appleCount = 0UL; // over all runs
+        auto play = [&appleCount](SnakeEnvironment &env, std::vector<Uint8> &board, std::vector<std::vector<Uint8>> &boards)
+        {
+            const SnakeEnvironment::Action action = chase_apple(board, env.get_config().width);
+            const SnakeEnvironment::StepResult result = env.step(action);
+            appleCount += result.reward > 0.0f;
+            if (result.done)
+                env.reset(env.get_score() + 11U);
+            env.export_board(board.data());
+            boards.push_back(board);
+        };
+
+        std::vector<std::vector<Uint8>> soloBoards[2], interleavedBoards[2];
+        for (int g = 0; g < 2; g++)
+        {
+            SnakeEnvironment env({10, 5});
+            env.reset(3U + g);
+            std::vector<Uint8> board(50U);
+            env.export_board(board.data());
+            for (int step = 0; step < STEP_COUNT; step++)
+                play(env, board, soloBoards[g]);
+        }
+
+        SnakeEnvironment envs[2] = {SnakeEnvironment({10, 5}), SnakeEnvironment({10, 5})};
+        std::vector<Uint8> boards[2] = {std::vector<Uint8>(50U), std::vector<Uint8>(50U)};
+        for (int g = 0; g < 2; g++)
+        {
+            envs[g].reset(3U + g);
+            envs[g].export_board(boards[g].data());
+        }
+        for (int step = 0; step < STEP_COUNT; step++)
+        {
+            for (int g = 0; g < 2; g++)
+                play(envs[g], boards[g], interleavedBoards[g]);
+        }
+
+        for (int g = 0; g < 2; g++)
+            EXPECT_EQ(interleavedBoards[g], soloBoards[g]);
+        EXPECT_GT(appleCount, 4UL); // bodies grew, so the previous maps mattered
+    }
+
+    TEST(SnakeEnvironmentTest, InstancesOnSeparateThreadsMatchSoloRuns)
+    {
+        constexpr int STEP_COUNT = 400;
+        auto play = [](const Uint64 &seed, std::vector<std::vector<Uint8>> &boards)
+        {
+            SnakeEnvironment env({12, 8});
+            env.reset(seed);
+            std::vector<Uint8> board(96U);
+            env.export_board(board.data());
+            for (int step = 0; step < STEP_COUNT; step++)
+            {
+                if (env.step(chase_apple(board, 12)).done)
+                    env.reset(seed + static_cast<Uint64>(step));
+                env.export_board(board.data());
+                boards.push_back(board);
+            }
+        };
+
+        std::vector<std::vector<Uint8>> soloBoards[2], threadBoards[2];
+        play(3U, soloBoards[0]);
+        play(4U, soloBoards[1]);
+        std::thread other(play, 4U, std::ref(threadBoards[1]));
+        play(3U, threadBoards[0]);
+        other.join();
+        EXPECT_EQ(threadBoards[0], soloBoards[0]);
+        EXPECT_EQ(threadBoards[1], soloBoards[1]);
+    }
+} // namespace
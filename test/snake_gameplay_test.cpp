@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include <component/position.hpp>
 #include <component/delta_time.hpp>
 #include <component/snake_part.hpp>
@@ -143,6 +146,216 @@ namespace
         EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == comp);
     }
 
+    TEST(SnakeGameplaySystemTest, EatingAppleWithoutInit)
+    { // the apple index is built on the first tick
+        entt::registry registry;
+        { // create game state entity; 3x1 map
+            auto entity = registry.create();
+            registry.emplace<KeyControl>(entity, 'd');
+            registry.emplace<DeltaTime>(entity, 100U);
+            registry.emplace<SnakeBoundary2D>(entity, 3, 1);
+        }
+        { // create apple
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 1.5f, 0.5f);
+            registry.emplace<SnakeApple>(entity);
+        }
+        { // create snake head
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 0.5f, 0.5f);
+            registry.emplace<Velocity>(entity, 0.0f, 0.0f);
+            registry.emplace<SnakePartHead>(entity, 10.0f, 1.0f); // 10 /s speed
+        }
+
+        SnakeGameplaySystem::update(registry); // to set the velocity of the snake head based on 'd'
+        SystemTranslate2D::update(registry);   // 0.1s has passed
+        SnakeGameplaySystem::update(registry);
+
+        // $ @ . -> x $ @
+        using namespace SnakeGameplaySystem;
+        std::vector<std::vector<MapSlotState>> comp(1, std::vector<MapSlotState>(3, MapSlotState::EMPTY));
+        comp[0][0] = MapSlotState::SNAKE_BODY;
+        comp[0][1] = MapSlotState::SNAKE_HEAD;
+        comp[0][2] = MapSlotState::APPLE;
+        EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == comp);
+        EXPECT_EQ(SnakeGameplaySystem::get_score(registry), 1UL);
+    }
+
+    TEST(SnakeGameplaySystemTest, ClearedAndRepopulatedWithoutInit)
+    { // reg.clear() keeps reg.ctx(), so the indices of the first scene MUST NOT leak into the second
+        entt::registry registry;
+        auto make_scene = [&registry](const float &appleX)
+        { // 5x1 map, head on the left
+            auto entity = registry.create();
+            registry.emplace<KeyControl>(entity, 'd');
+            registry.emplace<DeltaTime>(entity, 100U);
+            registry.emplace<SnakeBoundary2D>(entity, 5, 1);
+            auto appleEntity = registry.create();
+            registry.emplace<Position>(appleEntity, appleX, 0.5f);
+            registry.emplace<SnakeApple>(appleEntity);
+            auto headEntity = registry.create();
+            registry.emplace<Position>(headEntity, 0.5f, 0.5f);
+            registry.emplace<Velocity>(headEntity, 0.0f, 0.0f);
+            registry.emplace<SnakePartHead>(headEntity, 10.0f, 1.0f); // 10 /s speed
+        };
+        make_scene(3.5f);
+        SnakeGameplaySystem::init(registry);
+        registry.clear();
+        make_scene(1.5f); // no init()
+
+        SnakeGameplaySystem::update(registry); // to set the velocity of the snake head based on 'd'
+        SystemTranslate2D::update(registry);   // 0.1s has passed
+        SnakeGameplaySystem::update(registry);
+
+        // $ @ . . . -> x $ and the apple on one of the three free slots
+        using namespace SnakeGameplaySystem;
+        EXPECT_EQ(SnakeGameplaySystem::get_score(registry), 1UL);
+        const Map map = SnakeGameplaySystem::get_map(registry);
+        EXPECT_EQ(map[0][0], MapSlotState::SNAKE_BODY);
+        EXPECT_EQ(map[0][1], MapSlotState::SNAKE_HEAD);
+        EXPECT_EQ((map[0][2] == MapSlotState::APPLE) + (map[0][3] == MapSlotState::APPLE) + (map[0][4] == MapSlotState::APPLE), 1);
+        EXPECT_EQ(Detail::get_free_cells(registry, {5, 1}).cells.size(), 2U);
+    }
+
+    TEST(SnakeGameplaySystemTest, EatingOneOfManyApples)
+    {
+        entt::registry registry;
+        { // create game state entity; 5x1 map
+            auto entity = registry.create();
+            registry.emplace<KeyControl>(entity, 'd');
+            registry.emplace<DeltaTime>(entity, 100U);
+            registry.emplace<SnakeBoundary2D>(entity, 5, 1);
+        }
+        for (const float x : {2.5f, 4.5f})
+        { // create apples
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, x, 0.5f);
+            registry.emplace<SnakeApple>(entity);
+        }
+        { // create snake body
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 0.5f, 0.5f);
+            registry.emplace<SnakePart>(entity, 'd');
+        }
+        { // create snake head
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 1.5f, 0.5f);
+            registry.emplace<Velocity>(entity, 0.0f, 0.0f);
+            registry.emplace<SnakePartHead>(entity, 10.0f, 1.0f); // 10 /s speed
+        }
+
+        SnakeGameplaySystem::init(registry);
+        SnakeGameplaySystem::update(registry); // to set the velocity of the snake head based on 'd'
+        SystemTranslate2D::update(registry);   // 0.1s has passed
+        SnakeGameplaySystem::update(registry);
+
+        // x x $ @ @ ; the eaten apple can only go to the one empty slot
+        using namespace SnakeGameplaySystem;
+        std::vector<std::vector<MapSlotState>> comp(1, std::vector<MapSlotState>(5, MapSlotState::EMPTY));
+        comp[0][2] = MapSlotState::SNAKE_HEAD;
+        comp[0][1] = MapSlotState::SNAKE_BODY;
+        comp[0][0] = MapSlotState::SNAKE_BODY;
+        comp[0][3] = MapSlotState::APPLE;
+        comp[0][4] = MapSlotState::APPLE;
+        EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == comp);
+        EXPECT_EQ(registry.view<SnakeApple>().size(), 2U);
+
+        SystemTranslate2D::update(registry);
+        SnakeGameplaySystem::update(registry);
+
+        // x x x $ @ ; no empty slot left, so the eaten apple is gone
+        comp[0][3] = MapSlotState::SNAKE_HEAD;
+        comp[0][2] = MapSlotState::SNAKE_BODY;
+        EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == comp);
+        EXPECT_EQ(registry.view<SnakeApple>().size(), 1U);
+        EXPECT_EQ(SnakeGameplaySystem::get_score(registry), 3UL);
+    }
+
+    TEST(SnakeGameplaySystemTest, ObstaclesBlockApplesAndKillTheHead)
+    {
+        entt::registry registry;
+        { // create game state entity; 5x1 map, slots 3 and 4 blocked
+            auto entity = registry.create();
+            registry.emplace<KeyControl>(entity, 'd');
+            registry.emplace<DeltaTime>(entity, 100U);
+            registry.emplace<SnakeBoundary2D>(entity, 5, 1);
+        }
+        const Uint8 mask[5] = {0U, 0U, 0U, 1U, 1U};
+        SnakeGameplaySystem::load_obstacles(registry, {5, 1}, mask);
+        { // create apple
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 2.5f, 0.5f);
+            registry.emplace<SnakeApple>(entity);
+        }
+        { // create snake body
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 0.5f, 0.5f);
+            registry.emplace<SnakePart>(entity, 'd');
+        }
+        { // create snake head
+            auto entity = registry.create();
+            registry.emplace<Position>(entity, 1.5f, 0.5f);
+            registry.emplace<Velocity>(entity, 0.0f, 0.0f);
+            registry.emplace<SnakePartHead>(entity, 10.0f, 1.0f); // 10 /s speed
+        }
+
+        const SnakeGameplaySystem::ObstacleLayer *obstacles = SnakeGameplaySystem::find_obstacles(registry);
+        ASSERT_NE(obstacles, nullptr);
+        EXPECT_EQ(obstacles->freeCells, (std::vector<long>{0L, 1L, 2L}));
+        EXPECT_TRUE(obstacles->is_blocked(3L));
+        EXPECT_FALSE(obstacles->is_blocked(2L));
+
+        // x $ @ # #
+        using namespace SnakeGameplaySystem;
+        const std::vector<MapSlotState> row = {MapSlotState::SNAKE_BODY, MapSlotState::SNAKE_HEAD, MapSlotState::APPLE,
+                                               MapSlotState::OBSTACLE, MapSlotState::OBSTACLE};
+        EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == Map(1, row));
+        Uint8 board[5];
+        SnakeGameplaySystem::get_board(registry, board);
+        for (int k = 0; k < 5; k++)
+            EXPECT_EQ(board[k], row[k]);
+
+        SnakeGameplaySystem::init(registry);
+        SnakeGameplaySystem::update(registry); // to set the velocity of the snake head based on 'd'
+        SystemTranslate2D::update(registry);   // 0.1s has passed
+        SnakeGameplaySystem::update(registry);
+
+        // x x $ # # ; every reachable slot is filled, so the apple is gone and the game is won
+        EXPECT_EQ(registry.view<SnakeApple>().size(), 0U);
+        EXPECT_TRUE(SnakeGameplaySystem::is_game_success(registry));
+        EXPECT_FALSE(SnakeGameplaySystem::is_game_failure(registry));
+
+        SystemTranslate2D::update(registry);
+        EXPECT_TRUE(SnakeGameplaySystem::is_game_failure(registry)); // head on a blocked slot
+
+        SnakeGameplaySystem::load_obstacles(registry, {5, 1}, nullptr);
+        EXPECT_EQ(SnakeGameplaySystem::find_obstacles(registry), nullptr);
+    }
+
+    TEST(SnakeGameplaySystemTest, ParseLevel)
+    {
+        std::vector<Uint8> mask;
+        const std::string level = "#..#\r\n.#\n"; // CRLF, a short row and a missing one
+        ASSERT_TRUE(SnakeGameplaySystem::parse_level(level.data(), level.size(), {4, 3}, mask));
+        EXPECT_EQ(mask, (std::vector<Uint8>{1U, 0U, 0U, 1U, 0U, 1U, 0U, 0U, 0U, 0U, 0U, 0U}));
+
+        EXPECT_FALSE(SnakeGameplaySystem::parse_level("#...#", 5U, {4, 3}, mask));      // too wide
+        EXPECT_FALSE(SnakeGameplaySystem::parse_level("\n\n\n#", 4U, {4, 3}, mask));  // too tall
+        EXPECT_FALSE(SnakeGameplaySystem::parse_level("###\n#.#", 7U, {3, 2}, mask)); // room for the head only
+        EXPECT_TRUE(SnakeGameplaySystem::parse_level(nullptr, 0U, {3, 2}, mask));
+        EXPECT_EQ(mask, std::vector<Uint8>(6U, 0U));
+
+        entt::registry registry;
+        const Uint8 blocked[6] = {1U, 1U, 0U, 1U, 0U, 1U}; // # # . / # . #
+        SnakeGameplaySystem::load_obstacles(registry, {3, 2}, blocked);
+        EXPECT_EQ(SnakeGameplaySystem::find_open_cell(registry, {3, 2}, 2L), 2L);
+        EXPECT_EQ(SnakeGameplaySystem::find_open_cell(registry, {3, 2}, 0L), 2L);     // nearest open cell
+        const long takenCells[2] = {2L, 4L};
+        EXPECT_EQ(SnakeGameplaySystem::find_open_cell(registry, {3, 2}, 2L, takenCells, 1U), 4L); // the other one
+        EXPECT_EQ(SnakeGameplaySystem::find_open_cell(registry, {3, 2}, 4L, takenCells + 1, 1U), 2L);
+        EXPECT_EQ(SnakeGameplaySystem::find_open_cell(registry, {3, 2}, 2L, takenCells, 2U), -1L); // both taken
+    }
+
     TEST(SnakeGameplaySystemTest, TrailingDiagonallyWithApple)
     {
         entt::registry registry;
@@ -300,4 +513,148 @@ namespace
         // SnakeGameplaySystem::Debug::print_map(comp);                                   // NOTE: toggle to see
         EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == comp);
     }
+
+    entt::entity make_head(entt::registry &registry, const float &x, const float &y)
+    {
+        auto entity = registry.create();
+        registry.emplace<Position>(entity, x, y);
+        registry.emplace<Velocity>(entity, 0.0f, 0.0f);
+        registry.emplace<SnakePartHead>(entity, 10.0f, 1.0f); // 10 /s speed
+        return entity;
+    }
+
+    void make_part(entt::registry &registry, const float &x, const float &y, const char &currentDirection)
+    {
+        auto entity = registry.create();
+        registry.emplace<Position>(entity, x, y);
+        registry.emplace<SnakePart>(entity, currentDirection);
+    }
+
+    void make_state(entt::registry &registry, const int &width, const int &height)
+    {
+        auto entity = registry.create();
+        registry.emplace<KeyControl>(entity, 'd');
+        registry.emplace<DeltaTime>(entity, 100U);
+        registry.emplace<SnakeBoundary2D>(entity, width, height);
+    }
+
+    // One tick of 0.1s after the velocities are set, so every head moves one cell.
+    void run_one_cell(entt::registry &registry)
+    {
+        SnakeGameplaySystem::update(registry); // to set the velocities from the keys
+        SystemTranslate2D::update(registry);   // 0.1s has passed
+        SnakeGameplaySystem::update(registry);
+    }
+
+    TEST(SnakeGameplaySystemTest, SnakesTrailAndSteerOnTheirOwn)
+    {
+        entt::registry registry;
+        make_state(registry, 5, 3);
+        const entt::entity top = make_head(registry, 1.5f, 2.5f);
+        make_part(registry, 0.5f, 2.5f, 'd');
+        const entt::entity bottom = make_head(registry, 1.5f, 0.5f);
+        make_part(registry, 0.5f, 0.5f, 'd');
+        // x $ . . .
+        // . . . . .
+        // x $ . . .
+
+        SnakeGameplaySystem::init(registry);
+        SnakeGameplaySystem::Control::up_key_down(registry, bottom); // the top one keeps the scene's 'd'
+        run_one_cell(registry);
+
+        using namespace SnakeGameplaySystem;
+        std::vector<std::vector<MapSlotState>> comp(3, std::vector<MapSlotState>(5, MapSlotState::EMPTY));
+        comp[0][1] = MapSlotState::SNAKE_BODY;
+        comp[0][2] = MapSlotState::SNAKE_HEAD;
+        comp[1][1] = MapSlotState::SNAKE_HEAD;
+        comp[2][1] = MapSlotState::SNAKE_BODY;
+        // . x $ . .
+        // . $ . . .
+        // . x . . .
+        EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == comp);
+        EXPECT_FALSE(SnakeGameplaySystem::is_game_failure(registry));
+        EXPECT_FALSE(SnakeGameplaySystem::is_snake_failure(registry, top));
+        EXPECT_FALSE(SnakeGameplaySystem::is_snake_failure(registry, bottom));
+        EXPECT_EQ(SnakeGameplaySystem::get_score(registry, top), 1UL);
+        EXPECT_EQ(SnakeGameplaySystem::get_score(registry, bottom), 1UL);
+        EXPECT_EQ(SnakeGameplaySystem::get_score(registry), 2UL);
+    }
+
+    TEST(SnakeGameplaySystemTest, CrashedSnakeLeavesTheBoard)
+    {
+        entt::registry registry;
+        make_state(registry, 5, 2);
+        const entt::entity top = make_head(registry, 1.5f, 1.5f);
+        make_part(registry, 0.5f, 1.5f, 'd');
+        const entt::entity bottom = make_head(registry, 2.5f, 0.5f);
+        make_part(registry, 1.5f, 0.5f, 'd');
+        make_part(registry, 0.5f, 0.5f, 'd');
+        // x $ . . .
+        // x x $ . .
+
+        SnakeGameplaySystem::init(registry);
+        SnakeGameplaySystem::Control::down_key_down(registry, top); // into the middle of the other body
+        run_one_cell(registry);
+        EXPECT_TRUE(SnakeGameplaySystem::is_snake_failure(registry, top));
+        EXPECT_FALSE(SnakeGameplaySystem::is_game_failure(registry)); // the other one still runs
+
+        SnakeGameplaySystem::update(registry); // takes the crashed snake off the board
+        EXPECT_FALSE(registry.valid(top));
+        EXPECT_TRUE(SnakeGameplaySystem::is_snake_failure(registry, top));
+        EXPECT_EQ(SnakeGameplaySystem::get_score(registry, bottom), 2UL);
+
+        using namespace SnakeGameplaySystem;
+        std::vector<std::vector<MapSlotState>> comp(2, std::vector<MapSlotState>(5, MapSlotState::EMPTY));
+        comp[1][1] = MapSlotState::SNAKE_BODY;
+        comp[1][2] = MapSlotState::SNAKE_BODY;
+        comp[1][3] = MapSlotState::SNAKE_HEAD;
+        // . . . . .
+        // . x x $ .
+        EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == comp);
+        const SnakeGameplaySystem::FreeCells &freeCells = SnakeGameplaySystem::Detail::get_free_cells(registry, {5, 2});
+        EXPECT_EQ(freeCells.cells.size(), 7U);
+        for (long cell = 0; cell < 10L; cell++)
+            EXPECT_EQ(freeCells.contains(cell), comp[cell / 5][cell % 5] == MapSlotState::EMPTY) << cell;
+    }
+
+    TEST(SnakeGameplaySystemTest, HeadsMeetingEndTheGame)
+    {
+        entt::registry registry;
+        make_state(registry, 5, 1);
+        const entt::entity left = make_head(registry, 0.5f, 0.5f);
+        const entt::entity right = make_head(registry, 2.5f, 0.5f);
+        SnakeGameplaySystem::Control::left_key_down(registry, right);
+        // $ . $ . .
+
+        SnakeGameplaySystem::init(registry);
+        run_one_cell(registry);
+        EXPECT_TRUE(SnakeGameplaySystem::is_snake_failure(registry, left));
+        EXPECT_TRUE(SnakeGameplaySystem::is_snake_failure(registry, right));
+        EXPECT_TRUE(SnakeGameplaySystem::is_game_failure(registry));
+    }
+
+    TEST(SnakeGameplaySystemTest, HeadFollowsAnotherTail)
+    {
+        entt::registry registry;
+        make_state(registry, 5, 1);
+        const entt::entity follower = make_head(registry, 1.5f, 0.5f);
+        make_part(registry, 0.5f, 0.5f, 'd');
+        const entt::entity leader = make_head(registry, 3.5f, 0.5f);
+        make_part(registry, 2.5f, 0.5f, 'd');
+        // x $ x $ .
+
+        SnakeGameplaySystem::init(registry);
+        run_one_cell(registry); // the leader's tail moves out as the follower's head comes in
+        EXPECT_FALSE(SnakeGameplaySystem::is_snake_failure(registry, follower));
+        EXPECT_FALSE(SnakeGameplaySystem::is_snake_failure(registry, leader));
+
+        using namespace SnakeGameplaySystem;
+        std::vector<std::vector<MapSlotState>> comp(1, std::vector<MapSlotState>(5, MapSlotState::EMPTY));
+        comp[0][1] = MapSlotState::SNAKE_BODY;
+        comp[0][2] = MapSlotState::SNAKE_HEAD;
+        comp[0][3] = MapSlotState::SNAKE_BODY;
+        comp[0][4] = MapSlotState::SNAKE_HEAD;
+        // . x $ x $
+        EXPECT_TRUE(SnakeGameplaySystem::get_map(registry) == comp);
+    }
 } // namespace
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <component/position.hpp>
+#include <component/delta_time.hpp>
+#include <component/snake_part.hpp>
+#include <component/snake_part_head.hpp>
+#include <component/snake_boundary_2d.hpp>
+#include <component/snake_apple.hpp>
+#include <component/snake_autopilot.hpp>
+#include <system/translate_2d.hpp>
+#include <system/snake_gameplay_system.hpp>
+#include <system/snake_hamiltonian_solver.hpp>
+
+namespace
+{
+    void make_scene(entt::registry &registry, const int &width, const int &height, const bool &isShortcutEnabled)
+    {
+        auto entity = registry.create();
+        registry.emplace<KeyControl>(entity, 'd', false);
+        registry.emplace<DeltaTime>(entity, 25U);
+        registry.emplace<SnakeBoundary2D>(entity, width, height);
+        registry.emplace<SnakeAutopilot>(entity, isShortcutEnabled);
+
+        auto appleEntity = registry.create();
+        registry.emplace<Position>(appleEntity, static_cast<float>(width) - 0.5f, 0.5f);
+        registry.emplace<SnakeApple>(appleEntity);
+
+        auto snakeHeadEntity = registry.create();
+        registry.emplace<Position>(snakeHeadEntity, 0.5f, static_cast<float>(height) - 0.5f); // top left
+        registry.emplace<Velocity>(snakeHeadEntity, 0.0f, 0.0f);
+        registry.emplace<SnakePartHead>(snakeHeadEntity, 10.0f, 1.0f); // 0.25 unit per tick
+    }
+
+    bool run_until_game_over(entt::registry &registry, const long &maxTicks)
+    {
+        sigslot::signal<entt::registry &> signal; // connected directly since init() remembers signal addresses
+        signal.connect(SystemTranslate2D::iterate);
+        signal.connect(SnakeHamiltonianSolver::iterate);
+        signal.connect(SnakeGameplaySystem::iterate);
+        SnakeGameplaySystem::init(registry);
+        for (long tick = 0; tick < maxTicks; tick++)
+        {
+            if (SnakeGameplaySystem::is_game_success(registry) || SnakeGameplaySystem::is_game_failure(registry))
+                break;
+            signal(registry);
+        }
+        return SnakeGameplaySystem::is_game_success(registry);
+    }
+
+    TEST(SnakeHamiltonianSolverTest, CycleVisitsEveryCellOnce)
+    {
+        const SnakeBoundary2D boundaries[] = {{2, 2}, {4, 4}, {6, 3}, {3, 6}, {20, 20}, {100, 100}};
+        for (const SnakeBoundary2D &boundary : boundaries)
+        {
+            const SnakeHamiltonianSolver::Cycle *cycle = SnakeHamiltonianSolver::get_cycle(boundary);
+            ASSERT_NE(cycle, nullptr);
+            ASSERT_EQ(cycle->cells.size(), static_cast<size_t>(boundary.x * boundary.y));
+
+            std::vector<bool> isVisited(cycle->cells.size(), false);
+            for (size_t k = 0; k < cycle->cells.size(); k++)
+            {
+                const long cell = cycle->cells[k];
+                const long nextCell = cycle->cells[(k + 1) % cycle->cells.size()];
+                EXPECT_FALSE(isVisited[cell]);
+                isVisited[cell] = true;
+                EXPECT_EQ(cycle->order[cell], static_cast<long>(k));
+
+                const long di = SDL_abs(cell / boundary.x - nextCell / boundary.x);
+                const long dj = SDL_abs(cell % boundary.x - nextCell % boundary.x);
+                EXPECT_EQ(di + dj, 1L);
+            }
+        }
+    }
+
+    TEST(SnakeHamiltonianSolverTest, CycleIsCachedPerBoardSize)
+    {
+        const SnakeHamiltonianSolver::Cycle *first = SnakeHamiltonianSolver::get_cycle({8, 6});
+        const SnakeHamiltonianSolver::Cycle *second = SnakeHamiltonianSolver::get_cycle({8, 6});
+        EXPECT_NE(first, nullptr);
+        EXPECT_EQ(first, second);
+        EXPECT_NE(first, SnakeHamiltonianSolver::get_cycle({6, 8}));
+    }
+
+    TEST(SnakeHamiltonianSolverTest, CycleCacheIsSharedAcrossThreads)
+    {
+        const SnakeHamiltonianSolver::Cycle *cycles[4][8] = {};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++)
+        {
+            threads.emplace_back([&cycles, t]()
+                                 {
+                                     for (int k = 0; k < 8; k++) // sizes no other test builds, so the threads race to insert
+                                         cycles[t][k] = SnakeHamiltonianSolver::get_cycle({30 + 2 * k, 31}); });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        for (int k = 0; k < 8; k++)
+        {
+            ASSERT_NE(cycles[0][k], nullptr);
+            EXPECT_EQ(cycles[0][k]->cells.size(), static_cast<size_t>((30 + 2 * k) * 31));
+            for (int t = 1; t < 4; t++)
+                EXPECT_EQ(cycles[t][k], cycles[0][k]);
+        }
+    }
+
+    TEST(SnakeHamiltonianSolverTest, NoCycleForOddBoard)
+    {
+        EXPECT_EQ(SnakeHamiltonianSolver::get_cycle({3, 3}), nullptr);
+        EXPECT_EQ(SnakeHamiltonianSolver::get_cycle({5, 1}), nullptr);
+    }
+
+    TEST(SnakeHamiltonianSolverTest, FullBoardCompletion)
+    {
+        SDL_srand(1);
+
+        entt::registry registry1;
+        make_scene(registry1, 4, 4, false);
+        EXPECT_TRUE(run_until_game_over(registry1, 100000L));
+
+        entt::registry registry2;
+        make_scene(registry2, 6, 5, true);
+        EXPECT_TRUE(run_until_game_over(registry2, 100000L));
+    }
+
+    TEST(SnakeHamiltonianSolverTest, FreeCellsFollowAWholeGame)
+    { // the solver eats every apple, so every way a cell is taken or freed comes up
+        SDL_srand(3);
+        entt::registry registry;
+        make_scene(registry, 6, 4, true);
+        sigslot::signal<entt::registry &> signal;
+        signal.connect(SystemTranslate2D::iterate);
+        signal.connect(SnakeHamiltonianSolver::iterate);
+        signal.connect(SnakeGameplaySystem::iterate);
+        SnakeGameplaySystem::init(registry);
+        for (long tick = 0; tick < 100000L && !SnakeGameplaySystem::is_game_success(registry); tick++)
+        {
+            ASSERT_FALSE(SnakeGameplaySystem::is_game_failure(registry));
+            signal(registry);
+            const SnakeGameplaySystem::Map map = SnakeGameplaySystem::get_map(registry);
+            const SnakeGameplaySystem::FreeCells &freeCells = SnakeGameplaySystem::Detail::get_free_cells(registry, {6, 4});
+            size_t freeCount = 0U;
+            for (long cell = 0; cell < 24L; cell++)
+            {
+                const bool isFree = map[cell / 6][cell % 6] == SnakeGameplaySystem::MapSlotState::EMPTY;
+                ASSERT_EQ(freeCells.contains(cell), isFree) << "cell " << cell << " at tick " << tick;
+                freeCount += isFree;
+            }
+            ASSERT_EQ(freeCells.cells.size(), freeCount);
+        }
+        EXPECT_TRUE(SnakeGameplaySystem::is_game_success(registry));
+    }
+} // namespace
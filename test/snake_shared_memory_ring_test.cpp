@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <environment/snake_batch_environment.hpp>
+#include <environment/snake_shared_memory_ring.hpp>
+
+#ifdef SNAKE_HAS_SHARED_MEMORY_RING
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+    std::string get_test_ring_name() { return "/snake_ring_test_" + std::to_string(getpid()); }
+
+    TEST(SnakeSharedMemoryRingTest, PublishAndPeek)
+    {
+        const std::string name = get_test_ring_name();
+        SnakeBatchEnvironment batch(3U, {5, 3});
+        SnakeSharedMemoryRing producer;
+        ASSERT_TRUE(producer.create(name.c_str(), 3U, 5U, 3U, 2U));
+        SnakeSharedMemoryRing consumer;
+        ASSERT_TRUE(consumer.attach(name.c_str()));
+        EXPECT_EQ(consumer.get_header()->gameCount, 3U);
+        EXPECT_EQ(consumer.get_published_count(), 0U);
+
+        SnakeSharedMemoryRing::SlotView view;
+        EXPECT_FALSE(consumer.peek(1U, &view));
+
+        const SnakeEnvironment::Action actions[3] = {SnakeEnvironment::RIGHT, SnakeEnvironment::UP, SnakeEnvironment::DOWN};
+        float rewards[3];
+        Uint8 dones[3];
+        std::vector<Uint8> expected(batch.get_observation_size());
+        for (Uint64 count = 1U; count <= 3U; count++)
+        {
+            batch.step(actions, rewards, dones);
+            SnakeSharedMemoryRing::SlotView slot = producer.begin_publish();
+            batch.observe(slot.observations);
+            for (size_t g = 0; g < 3U; g++)
+            {
+                slot.scores[g] = static_cast<Uint32>(batch.get_score(g));
+                slot.dones[g] = dones[g];
+            }
+            producer.end_publish();
+
+            EXPECT_EQ(consumer.get_published_count(), count);
+            ASSERT_TRUE(consumer.peek(count, &view));
+            batch.observe(expected.data());
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), view.observations));
+            for (size_t g = 0; g < 3U; g++)
+                EXPECT_EQ(view.dones[g], dones[g]);
+            EXPECT_TRUE(consumer.is_slot_valid(count));
+        }
+        // 2 slots, so step 1 has been overwritten by step 3
+        EXPECT_FALSE(consumer.is_slot_valid(1U));
+        EXPECT_FALSE(consumer.peek(1U, &view));
+        EXPECT_TRUE(consumer.peek(2U, &view));
+    }
+
+    TEST(SnakeSharedMemoryRingTest, ActionsRoundTrip)
+    {
+        const std::string name = get_test_ring_name();
+        SnakeSharedMemoryRing producer;
+        ASSERT_TRUE(producer.create(name.c_str(), 4U, 4U, 4U, 4U));
+        SnakeSharedMemoryRing consumer;
+        ASSERT_TRUE(consumer.attach(name.c_str()));
+
+        Uint8 actions[4] = {0U, 0U, 0U, 0U};
+        EXPECT_FALSE(producer.read_actions(actions)); // nothing written yet
+
+        const Uint8 written[4] = {SnakeEnvironment::UP, SnakeEnvironment::LEFT, SnakeEnvironment::DOWN, SnakeEnvironment::RIGHT};
+        consumer.write_actions(written);
+        EXPECT_TRUE(producer.read_actions(actions));
+        EXPECT_TRUE(std::equal(actions, actions + 4, written));
+        EXPECT_FALSE(producer.read_actions(actions)); // already read
+
+        producer.close();
+        SnakeSharedMemoryRing late;
+        EXPECT_FALSE(late.attach(name.c_str())); // unlinked by its creator
+    }
+
+    TEST(SnakeSharedMemoryRingTest, AttachRejectsAHeaderThatDoesNotFit)
+    {
+        const std::string name = get_test_ring_name();
+        SnakeSharedMemoryRing producer;
+        ASSERT_TRUE(producer.create(name.c_str(), 8U, 20U, 20U, 4U));
+        const int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        ASSERT_GE(fd, 0);
+        void *mapped = mmap(nullptr, sizeof(SnakeSharedMemoryRing::Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ASSERT_NE(mapped, MAP_FAILED);
+        SnakeSharedMemoryRing::Header *header = static_cast<SnakeSharedMemoryRing::Header *>(mapped);
+
+        SnakeSharedMemoryRing consumer;
+        header->slotCount = 1000U; // slots past the end of the segment
+        EXPECT_FALSE(consumer.attach(name.c_str()));
+        header->slotCount = 4U;
+        header->slotSize /= 2U; // does not match the games it claims
+        EXPECT_FALSE(consumer.attach(name.c_str()));
+        header->slotSize *= 2U;
+        EXPECT_TRUE(consumer.attach(name.c_str()));
+        consumer.close();
+
+        ASSERT_EQ(ftruncate(fd, 4096), 0); // header intact, slots cut off
+        EXPECT_FALSE(consumer.attach(name.c_str()));
+        header->magic.store(0U); // as if create() had not published it yet
+        EXPECT_FALSE(consumer.attach(name.c_str()));
+        munmap(mapped, sizeof(SnakeSharedMemoryRing::Header));
+        close(fd);
+    }
+} // namespace
+#endif // SNAKE_HAS_SHARED_MEMORY_RING
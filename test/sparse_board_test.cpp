@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <utility>
+
+#include <environment/sparse_board.hpp>
+#include <environment/sparse_snake_environment.hpp>
+
+namespace
+{
+    TEST(SparseBoardTest, TilesFollowOccupiedCells)
+    {
+        SparseBoard board(10000, 10000);
+        EXPECT_EQ(board.get_tile_count(), 0U);
+        EXPECT_FALSE(board.is_occupied(9999, 9999));
+
+        board.occupy(0, 0);
+        board.occupy(63, 63);
+        board.occupy(64, 0);
+        board.occupy(9999, 9999);
+        EXPECT_EQ(board.get_occupied_count(), 4);
+        EXPECT_EQ(board.get_tile_count(), 3U);
+        EXPECT_TRUE(board.is_occupied(63, 63));
+        EXPECT_FALSE(board.is_occupied(62, 63));
+
+        board.release(64, 0);
+        EXPECT_EQ(board.get_tile_count(), 2U);
+        EXPECT_FALSE(board.is_occupied(64, 0));
+        EXPECT_EQ(board.get_allocated_tile_count(), 3U);
+        board.occupy(5000, 5000); // reuses the emptied tile
+        EXPECT_EQ(board.get_tile_count(), 3U);
+        EXPECT_EQ(board.get_allocated_tile_count(), 3U);
+        EXPECT_TRUE(board.is_occupied(5000, 5000));
+        EXPECT_FALSE(board.is_occupied(64, 0));
+        board.occupy(65, 1);
+        EXPECT_EQ(board.get_allocated_tile_count(), 4U);
+
+        board.clear();
+        EXPECT_EQ(board.get_occupied_count(), 0);
+        EXPECT_EQ(board.get_tile_count(), 0U);
+        EXPECT_FALSE(board.is_occupied(5000, 5000));
+        EXPECT_EQ(board.get_allocated_tile_count(), 4U);
+        board.occupy(5000, 5001);
+        EXPECT_EQ(board.get_tile_count(), 1U);
+        EXPECT_EQ(board.get_allocated_tile_count(), 4U);
+    }
+
+    TEST(SparseBoardTest, TableSurvivesChurn)
+    { // many tiles occupied and emptied in turn, growing the table and shifting keys back on removal
+        SparseBoard board(10000, 10000);
+        std::set<std::pair<Sint32, Sint32>> occupied;
+        Uint64 rngState = 7U;
+        for (int i = 0; i < 20000; i++)
+        {
+            const Sint32 x = SDL_rand_r(&rngState, 40) * SparseBoard::TILE_SIZE;
+            const Sint32 y = SDL_rand_r(&rngState, 40) * SparseBoard::TILE_SIZE;
+            if (occupied.erase({x, y}) != 0U)
+                board.release(x, y);
+            else
+            {
+                board.occupy(x, y);
+                occupied.insert({x, y});
+            }
+        }
+        EXPECT_EQ(board.get_tile_count(), occupied.size());
+        EXPECT_LE(board.get_allocated_tile_count(), 1600U);
+        for (Sint32 y = 0; y < 40 * SparseBoard::TILE_SIZE; y += SparseBoard::TILE_SIZE)
+        {
+            for (Sint32 x = 0; x < 40 * SparseBoard::TILE_SIZE; x += SparseBoard::TILE_SIZE)
+                ASSERT_EQ(board.is_occupied(x, y), occupied.count({x, y}) != 0U);
+        }
+    }
+
+    TEST(SparseBoardTest, SamplesOnlyFreeCells)
+    {
+        SparseBoard board(70, 5); // one full tile and one cut by the edge
+        for (Sint32 y = 0; y < 5; y++)
+        {
+            for (Sint32 x = 0; x < 70; x++)
+            {
+                if (x != 3 && !(x == 69 && y == 4))
+                    board.occupy(x, y);
+            }
+        }
+        Uint64 rngState = 42U;
+        std::set<std::pair<Sint32, Sint32>> seen;
+        for (int i = 0; i < 200; i++)
+        { // almost full: mostly the counting fallback
+            Sint32 x, y;
+            ASSERT_TRUE(board.sample_free_cell(&rngState, &x, &y));
+            ASSERT_FALSE(board.is_occupied(x, y));
+            seen.insert({x, y});
+        }
+        EXPECT_EQ(seen.size(), 6U);
+
+        for (Sint32 y = 0; y < 5; y++)
+            board.occupy(3, y);
+        board.occupy(69, 4);
+        Sint32 x, y;
+        EXPECT_FALSE(board.sample_free_cell(&rngState, &x, &y));
+    }
+
+    TEST(SparseSnakeEnvironmentTest, HugeArena)
+    {
+        SparseSnakeEnvironment env(10000, 10000);
+        env.reset(7U);
+        EXPECT_EQ(env.get_head().x, 0);
+        EXPECT_EQ(env.get_head().y, 5000);
+
+        for (int i = 0; i < 9998; i++)
+            ASSERT_FALSE(env.step(SnakeEnvironment::NONE).done);
+        const SnakeEnvironment::StepResult result = env.step(SnakeEnvironment::RIGHT); // onto the apple in the last column
+        EXPECT_FLOAT_EQ(result.reward, SnakeEnvironment::APPLE_REWARD);
+        EXPECT_EQ(env.get_score(), 1UL);
+        EXPECT_LE(env.get_board().get_tile_count(), 2U); // the snake never covered more than two tiles at once
+        EXPECT_LE(env.get_board().get_allocated_tile_count(), 2U); // emptied tiles are reused along the row
+        EXPECT_FALSE(env.is_occupied(env.get_apple().x, env.get_apple().y));
+
+        const SnakeEnvironment::StepResult wallResult = env.step(SnakeEnvironment::LEFT); // reversing is ignored, so the head hits the wall
+        EXPECT_TRUE(wallResult.done);
+        EXPECT_FLOAT_EQ(wallResult.reward, SnakeEnvironment::FAILURE_REWARD);
+        EXPECT_TRUE(env.step(SnakeEnvironment::UP).done); // until reset()
+    }
+
+    TEST(SparseSnakeEnvironmentTest, CycleWalkFillsTheBoard)
+    { // a Hamiltonian cycle never collides, so the body ring grows to every cell
+        constexpr Sint32 WIDTH = 8;
+        constexpr Sint32 HEIGHT = 6; // MUST BE even for this cycle
+        SparseSnakeEnvironment env(WIDTH, HEIGHT);
+        env.reset(3U);
+        SnakeEnvironment::StepResult result{0.0f, false};
+        for (int step = 0; step < 10000 && !result.done; step++)
+        {
+            const SparseSnakeEnvironment::Cell head = env.get_head();
+            SnakeEnvironment::Action action;
+            if (head.x == 0)
+                action = head.y == 0 ? SnakeEnvironment::RIGHT : SnakeEnvironment::UP;
+            else if (head.y % 2 == 0)
+                action = head.x < WIDTH - 1 ? SnakeEnvironment::RIGHT : SnakeEnvironment::DOWN;
+            else
+                action = head.y == HEIGHT - 1 || head.x > 1 ? SnakeEnvironment::LEFT : SnakeEnvironment::DOWN;
+            result = env.step(action);
+        }
+        EXPECT_TRUE(result.done);
+        EXPECT_FLOAT_EQ(result.reward, SnakeEnvironment::APPLE_REWARD + SnakeEnvironment::SUCCESS_REWARD);
+        EXPECT_EQ(env.get_score(), static_cast<unsigned long>(WIDTH * HEIGHT - 1));
+        EXPECT_EQ(env.get_board().get_occupied_count(), WIDTH * HEIGHT);
+    }
+
+    TEST(SparseSnakeEnvironmentTest, FillingTheBoardWins)
+    {
+        SparseSnakeEnvironment env(2, 1);
+        const SnakeEnvironment::StepResult result = env.step(SnakeEnvironment::NONE);
+        EXPECT_TRUE(result.done);
+        EXPECT_FLOAT_EQ(result.reward, SnakeEnvironment::APPLE_REWARD + SnakeEnvironment::SUCCESS_REWARD);
+        EXPECT_EQ(env.get_score(), 1UL);
+    }
+} // namespace
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <entt/entt.hpp>
+
+#include <system/system_pipeline.hpp>
+
+namespace
+{
+    std::string callOrder;
+
+    void first_system(entt::registry &) { callOrder += 'a'; }
+    void second_system(entt::registry &) { callOrder += 'b'; }
+    void third_system(entt::registry &) { callOrder += 'c'; }
+
+    TEST(SystemPipelineTest, RunsSystemsInOrder)
+    {
+        using Pipeline = SystemPipeline<first_system, second_system, third_system, first_system>;
+        static_assert(Pipeline::SYSTEM_COUNT == 4U, "");
+
+        entt::registry registry;
+        callOrder.clear();
+        Pipeline::iterate(registry);
+        Pipeline::update(registry);
+        EXPECT_EQ(callOrder, "abcaabca");
+    }
+
+    TEST(SystemPipelineTest, EmptyPipelineDoesNothing)
+    {
+        using Pipeline = SystemPipeline<>;
+        static_assert(Pipeline::SYSTEM_COUNT == 0U, "");
+
+        entt::registry registry;
+        callOrder.clear();
+        Pipeline::iterate(registry);
+        EXPECT_TRUE(callOrder.empty());
+    }
+} // namespace
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <entt/entt.hpp>
+
+#include <component/delta_time.hpp>
+#include <component/position.hpp>
+#include <component/velocity.hpp>
+#include <system/system_scheduler.hpp>
+#include <system/translate_2d.hpp>
+
+namespace
+{
+    struct Heat
+    {
+        float value;
+    }; // struct Heat
+
+    void damp_velocity(entt::registry &reg)
+    {
+        reg.view<Velocity>().each([](Velocity &vel)
+                                  {
+                        vel.x *= 0.5f;
+                        vel.y *= 0.5f; });
+    }
+
+    void cool_down(entt::registry &reg)
+    {
+        reg.view<Heat>().each([](Heat &heat)
+                              { heat.value -= 1.0f; });
+    }
+
+    void spawn_particle(entt::registry &reg)
+    {
+        const entt::entity entity = reg.create();
+        reg.emplace<Position>(entity, 0.0f, 0.0f);
+        reg.emplace<Velocity>(entity, 1.0f, 1.0f);
+        reg.emplace<Heat>(entity, 10.0f);
+    }
+
+    struct TickCount
+    {
+        int value = 0;
+    }; // struct TickCount
+
+    void count_tick(entt::registry &reg) { reg.ctx().find<TickCount>()->value++; } // the scheduler created it
+
+    int lastSeenTickCount = -1;
+    void read_tick_count(entt::registry &reg) { lastSeenTickCount = reg.ctx().find<TickCount>()->value; }
+
+    void add_systems(SystemScheduler &scheduler)
+    {
+        scheduler.add(SystemTranslate2D::iterate, Reads<DeltaTime, Velocity>{}, Writes<Position>{});
+        scheduler.add(cool_down, Reads<>{}, Writes<Heat>{});
+        scheduler.add(damp_velocity, Reads<>{}, Writes<Velocity>{});
+        scheduler.add(spawn_particle, Reads<>{}, Writes<entt::entity, Position, Velocity, Heat>{});
+    }
+
+    TEST(SystemSchedulerTest, ConflictingSystemsGetLaterStages)
+    {
+        WorkerPool pool(2U);
+        SystemScheduler scheduler(pool);
+        add_systems(scheduler);
+
+        ASSERT_EQ(scheduler.get_system_count(), 4U);
+        EXPECT_EQ(scheduler.get_stage(0U), 0U);
+        EXPECT_EQ(scheduler.get_stage(1U), 0U); // touches nothing translate does
+        EXPECT_EQ(scheduler.get_stage(2U), 1U); // writes what translate reads
+        EXPECT_EQ(scheduler.get_stage(3U), 2U); // structural
+        EXPECT_EQ(scheduler.get_stage_count(), 3U);
+    }
+
+    TEST(SystemSchedulerTest, ContextVariablesConflictAndArePreCreated)
+    {
+        WorkerPool pool(2U);
+        SystemScheduler scheduler(pool);
+        scheduler.add(count_tick, Reads<>{}, Writes<Ctx<TickCount>>{});
+        scheduler.add(cool_down, Reads<>{}, Writes<Heat>{});
+        scheduler.add(read_tick_count, Reads<Ctx<TickCount>>{}, Writes<>{});
+        scheduler.add(damp_velocity, Reads<TickCount>{}, Writes<Velocity>{}); // the component, not the variable
+
+        EXPECT_EQ(scheduler.get_stage(1U), 0U);
+        EXPECT_EQ(scheduler.get_stage(2U), 1U); // reads what count_tick writes
+        EXPECT_EQ(scheduler.get_stage(3U), 0U);
+
+        entt::registry reg;
+        EXPECT_FALSE(reg.ctx().contains<TickCount>());
+        for (int tick = 0; tick < 3; tick++)
+            scheduler.iterate(reg);
+        ASSERT_TRUE(reg.ctx().contains<TickCount>());
+        EXPECT_EQ(reg.ctx().find<TickCount>()->value, 3);
+        EXPECT_EQ(lastSeenTickCount, 3);
+    }
+
+    TEST(SystemSchedulerTest, MatchesSerialOrder)
+    {
+        WorkerPool pool(3U);
+        SystemScheduler scheduler(pool);
+        add_systems(scheduler);
+
+        entt::registry parallelReg, serialReg;
+        for (entt::registry *reg : {&parallelReg, &serialReg})
+        {
+            reg->emplace<DeltaTime>(reg->create(), 100U);
+            for (int i = 0; i < 50; i++)
+                spawn_particle(*reg);
+        }
+        for (int tick = 0; tick < 20; tick++)
+        {
+            scheduler.iterate(parallelReg);
+
+            SystemTranslate2D::iterate(serialReg);
+            cool_down(serialReg);
+            damp_velocity(serialReg);
+            spawn_particle(serialReg);
+        }
+
+        auto parallelView = parallelReg.view<Position, Velocity, Heat>();
+        auto serialView = serialReg.view<Position, Velocity, Heat>();
+        ASSERT_EQ(parallelReg.view<Heat>().size(), serialReg.view<Heat>().size());
+        for (const entt::entity entity : serialView)
+        {
+            EXPECT_EQ(parallelView.get<Position>(entity).x, serialView.get<Position>(entity).x);
+            EXPECT_EQ(parallelView.get<Position>(entity).y, serialView.get<Position>(entity).y);
+            EXPECT_EQ(parallelView.get<Velocity>(entity).x, serialView.get<Velocity>(entity).x);
+            EXPECT_EQ(parallelView.get<Heat>(entity).value, serialView.get<Heat>(entity).value);
+        }
+    }
+} // namespace
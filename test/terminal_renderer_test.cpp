@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <render/terminal_renderer.hpp>
+
+namespace
+{
+    TEST(TerminalRendererTest, FirstFrameDrawsEverything)
+    {
+        const std::vector<Uint8> board = {SnakeGameplaySystem::EMPTY, SnakeGameplaySystem::APPLE,
+                                          SnakeGameplaySystem::SNAKE_BODY, SnakeGameplaySystem::SNAKE_HEAD | SnakeGameplaySystem::APPLE};
+        TerminalRenderer renderer;
+        const std::string frame = renderer.draw(board.data(), 2, 2, "Score: 1");
+        EXPECT_EQ(frame, "\x1b[?25l\x1b[0m\x1b[2J"
+                         "\x1b[1;1H\x1b[90m. \x1b[31m@ "
+                         "\x1b[2;1H\x1b[32mx \x1b[34m$ "
+                         "\x1b[4;1H\x1b[0m\x1b[2KScore: 1");
+
+        EXPECT_EQ(renderer.draw(board.data(), 2, 2, "Score: 1"), ""); // nothing changed
+    }
+
+    TEST(TerminalRendererTest, ObstaclesUnderTheHeadDrawTheHead)
+    {
+        std::vector<Uint8> board = {SnakeGameplaySystem::OBSTACLE, SnakeGameplaySystem::SNAKE_HEAD};
+        TerminalRenderer renderer;
+        renderer.draw(board.data(), 2, 1, "");
+        board[0] = SnakeGameplaySystem::OBSTACLE | SnakeGameplaySystem::SNAKE_HEAD; // crashed
+        board[1] = SnakeGameplaySystem::OBSTACLE;
+        EXPECT_EQ(renderer.draw(board.data(), 2, 1, ""), "\x1b[1;1H\x1b[34m$ \x1b[37m# ");
+    }
+
+    TEST(TerminalRendererTest, LaterFramesDrawOnlyChanges)
+    {
+        std::vector<Uint8> board(6U * 3U, SnakeGameplaySystem::EMPTY);
+        TerminalRenderer renderer;
+        renderer.draw(board.data(), 6, 3, "");
+
+        board[1 * 6 + 2] = SnakeGameplaySystem::SNAKE_BODY;
+        board[1 * 6 + 3] = SnakeGameplaySystem::SNAKE_HEAD;
+        board[2 * 6 + 5] = SnakeGameplaySystem::APPLE;
+        EXPECT_EQ(renderer.draw(board.data(), 6, 3, ""), "\x1b[2;5H\x1b[32mx \x1b[34m$ \x1b[3;11H\x1b[31m@ ");
+
+        board[1 * 6 + 2] = SnakeGameplaySystem::EMPTY;
+        const std::string expected = "\x1b[2;5H\x1b[90m. \x1b[5;1H\x1b[0m\x1b[2Kover";
+        EXPECT_EQ(renderer.draw(board.data(), 6, 3, "over"), expected);
+
+        std::FILE *file = std::tmpfile();
+        ASSERT_NE(file, nullptr);
+        EXPECT_TRUE(renderer.present(file));
+        EXPECT_EQ(std::ftell(file), static_cast<long>(expected.size())); // in one piece
+        std::fclose(file);
+
+        std::vector<Uint8> biggerBoard(7U * 3U, SnakeGameplaySystem::EMPTY);
+        const std::string frame = renderer.draw(biggerBoard.data(), 7, 3, "over");
+        EXPECT_EQ(frame.rfind("\x1b[?25l\x1b[0m\x1b[2J", 0), 0U); // new size, full redraw
+        EXPECT_NE(frame.find("over"), std::string::npos);
+    }
+} // namespace
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <profiler/tick_profiler.hpp>
+
+namespace
+{
+    TEST(TickProfilerTest, BucketBoundsContainValue)
+    {
+        const Uint64 values[] = {0U, 1U, 7U, 8U, 15U, 16U, 17U, 1000U, 123456U, 999999999U, 1ULL << 39};
+        for (const Uint64 &value : values)
+        {
+            const int index = TickProfiler::Detail::get_bucket_index(value);
+            ASSERT_GE(index, 0);
+            ASSERT_LT(index, TickProfiler::BUCKET_COUNT);
+            EXPECT_GE(TickProfiler::Detail::get_bucket_upper_bound(index), value);
+            if (index > 0)
+            {
+                EXPECT_LT(TickProfiler::Detail::get_bucket_upper_bound(index - 1), value);
+            }
+        }
+        EXPECT_EQ(TickProfiler::Detail::get_bucket_index(~0ULL), TickProfiler::BUCKET_COUNT - 1);
+    }
+
+    TEST(TickProfilerTest, Percentiles)
+    {
+        TickProfiler::reset();
+        for (Uint64 ns = 1U; ns <= 1000U; ns++)
+            TickProfiler::record(TickProfiler::GET_MAP, ns * 1000U);
+
+        const TickProfiler::Summary summary = TickProfiler::get_summary(TickProfiler::GET_MAP);
+        EXPECT_EQ(summary.count, 1000U);
+        EXPECT_EQ(summary.maxNs, 1000000U);
+        EXPECT_EQ(summary.meanNs, 500500U);
+        EXPECT_GE(summary.p50Ns, 500000U);
+        EXPECT_LE(summary.p50Ns, 500000U * 9U / 8U);
+        EXPECT_GE(summary.p99Ns, 990000U);
+        EXPECT_LE(summary.p99Ns, 1000000U);
+
+        EXPECT_EQ(TickProfiler::get_summary(TickProfiler::RENDER).count, 0U);
+    }
+
+    TEST(TickProfilerTest, MergesThreadsAndScopedTimer)
+    {
+        TickProfiler::reset();
+        std::thread worker([]()
+                           {
+                               for (int i = 0; i < 100; i++)
+                                   TickProfiler::record(TickProfiler::TICK, 10U); });
+        worker.join(); // samples outlive the thread
+        {
+            const TickProfiler::ScopedTimer timer(TickProfiler::TICK);
+        }
+
+        const TickProfiler::Summary summary = TickProfiler::get_summary(TickProfiler::TICK);
+        EXPECT_EQ(summary.count, 101U);
+        EXPECT_EQ(summary.p50Ns, 10U);
+        EXPECT_GE(summary.maxNs, 10U);
+    }
+} // namespace
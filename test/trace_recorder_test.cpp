@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <profiler/trace_recorder.hpp>
+
+namespace
+{
+    size_t count_occurrences(const std::string &haystack, const std::string &needle)
+    {
+        size_t ret = 0U;
+        for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1U))
+            ret++;
+        return ret;
+    }
+
+    std::string read_file(const char *path)
+    {
+        std::ifstream stream(path);
+        std::stringstream buffer;
+        buffer << stream.rdbuf();
+        return buffer.str();
+    }
+
+    TEST(TraceRecorderTest, NothingRecordedWhileStopped)
+    {
+        EXPECT_FALSE(TraceRecorder::is_recording());
+        {
+            SNAKE_TRACE_SCOPE("ignored");
+        }
+        EXPECT_EQ(TraceRecorder::Detail::get_thread_ring().head.load(), TraceRecorder::Detail::get_thread_ring().tail.load());
+    }
+
+    TEST(TraceRecorderTest, WritesOneCompleteEventPerScopeFromEveryThread)
+    {
+        const char *path = "trace_recorder_test.json";
+        ASSERT_TRUE(TraceRecorder::start(path));
+        EXPECT_FALSE(TraceRecorder::start(path));
+
+        auto work = []()
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                SNAKE_TRACE_SCOPE("outer");
+                SNAKE_TRACE_SCOPE("inner");
+            }
+        };
+        std::thread worker(work);
+        work();
+        worker.join();
+        TraceRecorder::stop();
+        EXPECT_FALSE(TraceRecorder::is_recording());
+
+        const std::string json = read_file(path);
+        std::remove(path);
+        ASSERT_FALSE(json.empty());
+        EXPECT_EQ(json.front(), '[');
+        EXPECT_EQ(json.substr(json.size() - 2U), "]\n");
+        const size_t written = 4000U - static_cast<size_t>(TraceRecorder::get_dropped_count());
+        EXPECT_EQ(count_occurrences(json, "\"ph\":\"X\""), written); // a dropped scope leaves no unpaired event
+        EXPECT_EQ(count_occurrences(json, "\"dur\":"), written);
+        if (TraceRecorder::get_dropped_count() == 0U)
+        {
+            EXPECT_EQ(count_occurrences(json, "{\"name\":\"outer\",\"ph\":\"X\""), 2000U);
+            EXPECT_EQ(count_occurrences(json, "{\"name\":\"inner\",\"ph\":\"X\""), 2000U);
+        }
+        EXPECT_EQ(count_occurrences(json, "\"tid\":"), written);
+    }
+} // namespace
@@ -4,6 +4,7 @@
 #include <component/velocity.hpp>
 #include <component/delta_time.hpp>
 #include <system/translate_2d.hpp>
+#include <system/worker_pool.hpp>
 
 namespace
 {
@@ -129,4 +130,79 @@ namespace
         EXPECT_FALSE(SystemTranslate2D::init(mainMenuSceneSignal));
         EXPECT_FALSE(SystemTranslate2D::init(creditsSceneSignal));
     }
+
+    void emplace_particles(entt::registry &reg, const int &count)
+    { // every third entity has no Velocity, so it is outside the group
+        reg.emplace<DeltaTime>(reg.create(), 16U);
+        for (int i = 0; i < count; i++)
+        {
+            const entt::entity entity = reg.create();
+            reg.emplace<Position>(entity, 0.5f * i, -0.25f * i);
+            if (i % 3 != 2)
+                reg.emplace<Velocity>(entity, 1.0f + 0.01f * i, 3.0f - 0.03f * i);
+        }
+    }
+
+    TEST(Translate2DSystemTest, GroupMatchesView)
+    {
+        for (const int count : {1, 2, 5, 1000, 3100}) // partial SIMD widths and several pages
+        {
+            entt::registry viewReg, groupReg;
+            emplace_particles(viewReg, count);
+            emplace_particles(groupReg, count);
+            SystemTranslate2D::use_group(groupReg);
+
+            for (int i = 0; i < 10; i++)
+            {
+                SystemTranslate2D::iterate(viewReg);
+                SystemTranslate2D::iterate(groupReg);
+            }
+
+            for (const entt::entity entity : viewReg.view<Position>())
+            { // bit-identical, not just close
+                const Position &expected = viewReg.get<Position>(entity);
+                const Position &actual = groupReg.get<Position>(entity);
+                ASSERT_EQ(actual.x, expected.x) << count << " entities";
+                ASSERT_EQ(actual.y, expected.y) << count << " entities";
+            }
+        }
+    }
+
+    TEST(Translate2DSystemTest, KernelTail)
+    {
+        Position pos[3] = {{0.0f, 0.0f}, {1.0f, 1.0f}, {2.0f, 2.0f}};
+        const Velocity vel[3] = {{1.0f, -1.0f}, {2.0f, -2.0f}, {3.0f, -3.0f}};
+        SystemTranslate2D::Detail::translate(pos, vel, 3U, 0.5f);
+        EXPECT_FLOAT_EQ(pos[0].x, 0.5f);
+        EXPECT_FLOAT_EQ(pos[0].y, -0.5f);
+        EXPECT_FLOAT_EQ(pos[1].x, 2.0f);
+        EXPECT_FLOAT_EQ(pos[1].y, 0.0f);
+        EXPECT_FLOAT_EQ(pos[2].x, 3.5f);
+        EXPECT_FLOAT_EQ(pos[2].y, 0.5f);
+    }
+
+    TEST(Translate2DSystemTest, WorkerPoolMatchesSerial)
+    {
+        WorkerPool pool(3U);
+        const int count = static_cast<int>(SystemTranslate2D::PARALLEL_THRESHOLD) * 3 / 2 + 7; // several pages, last one partial
+        entt::registry serialReg, parallelReg;
+        emplace_particles(serialReg, count);
+        emplace_particles(parallelReg, count);
+        SystemTranslate2D::use_group(serialReg);
+        SystemTranslate2D::use_worker_pool(parallelReg, pool);
+
+        for (int i = 0; i < 5; i++)
+        {
+            SystemTranslate2D::iterate(serialReg);
+            SystemTranslate2D::iterate(parallelReg);
+        }
+
+        for (const entt::entity entity : serialReg.view<Position>())
+        {
+            const Position &expected = serialReg.get<Position>(entity);
+            const Position &actual = parallelReg.get<Position>(entity);
+            ASSERT_EQ(actual.x, expected.x);
+            ASSERT_EQ(actual.y, expected.y);
+        }
+    }
 } // namespace
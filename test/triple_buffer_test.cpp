@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+
+#include <render/triple_buffer.hpp>
+
+namespace
+{
+    TEST(TripleBufferTest, ReaderSeesLatestPublished)
+    {
+        TripleBuffer<int> buffer;
+        EXPECT_FALSE(buffer.update());
+        EXPECT_EQ(buffer.get_read_buffer(), 0);
+
+        buffer.get_write_buffer() = 1;
+        buffer.publish();
+        buffer.get_write_buffer() = 2;
+        buffer.publish(); // 1 is skipped
+        ASSERT_TRUE(buffer.update());
+        EXPECT_EQ(buffer.get_read_buffer(), 2);
+        EXPECT_FALSE(buffer.update());
+        EXPECT_EQ(buffer.get_read_buffer(), 2);
+
+        buffer.get_write_buffer() = 3;
+        EXPECT_EQ(buffer.get_read_buffer(), 2); // unpublished writes stay invisible
+        buffer.publish();
+        ASSERT_TRUE(buffer.update());
+        EXPECT_EQ(buffer.get_read_buffer(), 3);
+    }
+
+    TEST(TripleBufferTest, WriterNeverTouchesReadBuffer)
+    {
+        struct Value
+        {
+            std::array<Uint64, 16> words;
+        }; // struct Value
+        static constexpr Uint64 PUBLISH_COUNT = 200000U;
+
+        TripleBuffer<Value> buffer;
+        std::thread writer([&buffer]()
+                           {
+            for (Uint64 i = 1U; i <= PUBLISH_COUNT; i++)
+            {
+                Value &value = buffer.get_write_buffer();
+                value.words.fill(i);
+                buffer.publish();
+            } });
+
+        Uint64 previous = 0U;
+        while (previous != PUBLISH_COUNT)
+        {
+            if (!buffer.update())
+                continue;
+            const Value &value = buffer.get_read_buffer();
+            const Uint64 first = value.words.front();
+            for (const Uint64 &word : value.words)
+                ASSERT_EQ(word, first); // torn otherwise
+            ASSERT_GT(first, previous);
+            previous = first;
+        }
+        writer.join();
+    }
+} // namespace
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include <system/worker_pool.hpp>
+
+namespace
+{
+    TEST(WorkerPoolTest, RunsEveryTaskOnce)
+    {
+        WorkerPool pool(3U);
+        EXPECT_EQ(pool.get_thread_count(), 4U);
+        for (size_t taskCount : {0U, 1U, 2U, 7U, 1000U})
+        {
+            std::vector<std::atomic<int>> calls(taskCount);
+            pool.run(taskCount, [&calls](const size_t &i)
+                     { calls[i].fetch_add(1); });
+            for (size_t i = 0U; i < taskCount; i++)
+                EXPECT_EQ(calls[i].load(), 1) << "task " << i << " of " << taskCount;
+        }
+    }
+
+    TEST(WorkerPoolTest, ReusedAcrossManyRuns)
+    {
+        WorkerPool pool(2U);
+        std::atomic<size_t> sum{0U};
+        for (int run = 0; run < 500; run++)
+            pool.run(8U, [&sum](const size_t &i)
+                     { sum.fetch_add(i); });
+        EXPECT_EQ(sum.load(), 500U * 28U);
+    }
+
+    TEST(WorkerPoolTest, NoWorkersRunsOnCaller)
+    {
+        WorkerPool pool(0U);
+        EXPECT_EQ(pool.get_thread_count(), 1U);
+        std::vector<size_t> order;
+        pool.run(4U, [&order](const size_t &i)
+                 { order.push_back(i); });
+        EXPECT_EQ(order, (std::vector<size_t>{0U, 1U, 2U, 3U}));
+    }
+
+    TEST(WorkerPoolTest, NestedRunIsInline)
+    {
+        WorkerPool pool(2U);
+        std::atomic<size_t> innerCalls{0U};
+        pool.run(4U, [&pool, &innerCalls](const size_t &)
+                 { pool.run(3U, [&innerCalls](const size_t &)
+                            { innerCalls.fetch_add(1U); }); });
+        EXPECT_EQ(innerCalls.load(), 12U);
+    }
+} // namespace